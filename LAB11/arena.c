@@ -0,0 +1,80 @@
+#include "cilisp.h"
+
+// arenaAlloc:
+// Returns size zeroed bytes from arena, like calloc. Allocation is a pointer
+// bump inside the current block; when it is full the next retained block is
+// reused, and a new block is only malloc'd when none is left that fits.
+void *arenaAlloc(ARENA *arena, size_t size)
+{
+    ARENA_BLOCK *block = arena->current;
+
+    // keep every allocation aligned like malloc's
+    size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+
+    while (block == NULL || block->used + size > block->size)
+    {
+        if (block != NULL && block->next != NULL)
+        {
+            block = block->next;
+            block->used = 0;
+            continue;
+        }
+
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        ARENA_BLOCK *newBlock;
+        if ((newBlock = malloc(sizeof(ARENA_BLOCK) + blockSize)) == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+        newBlock->size = blockSize;
+        newBlock->used = 0;
+
+        // a block too small for this request stays in the chain for later ones
+        if (block == NULL)
+        {
+            newBlock->next = arena->first;
+            arena->first = newBlock;
+        }
+        else
+        {
+            newBlock->next = block->next;
+            block->next = newBlock;
+        }
+        block = newBlock;
+    }
+
+    arena->current = block;
+    void *memory = (char *) block->data + block->used;
+    block->used += size;
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+// arenaReset:
+// Releases everything allocated from arena at once. The blocks are kept for
+// the next expression, so memory stays bounded by the largest one so far.
+void arenaReset(ARENA *arena)
+{
+    arena->current = arena->first;
+    if (arena->first != NULL)
+    {
+        arena->first->used = 0;
+    }
+}
+
+// arenaFree:
+// Gives every block back to malloc, when nothing more will be parsed.
+void arenaFree(ARENA *arena)
+{
+    ARENA_BLOCK *block = arena->first;
+
+    while (block != NULL)
+    {
+        ARENA_BLOCK *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+}
@@ -0,0 +1,293 @@
+#include <pthread.h>
+#include "cilisp.h"
+
+// batch:
+// Parallel evaluation of a batch input (-j). Top-level expressions share
+// nothing, so the input is cut into chunks of whole lines at nesting depth
+// zero, and each chunk is parsed and evaluated by whichever worker thread
+// takes it, on that worker's own PARSER and VM. A chunk's output is
+// collected in memory, and main's thread writes the chunks out strictly in
+// input order, so stdout holds exactly what one parse would have written.
+// Chunks that call read or rand would see other numbers if they ran out of
+// order, so they all go to a single serial lane that runs them in input
+// order on one VM, alongside the workers.
+// Outside TEXT_OUTPUT a chunk's parse warnings and errors are collected too,
+// and written to stderr in the same order; warnings from evaluation still go
+// straight to stderr, in no set order.
+
+#define MIN_CHUNK_SIZE (4 * 1024)
+#define MAX_CHUNK_SIZE (256 * 1024)
+#define CHUNKS_PER_JOB 16
+#define WINDOW_PER_JOB 4        // chunks finished or running ahead of the writer
+
+typedef struct chunk {
+    char *text;
+    size_t length;
+    bool serial;        // calls read or rand, so it runs on the serial lane
+    bool done;
+    bool stopped;       // quit, the EOF character or a syntax error ended the input in it
+    bool failed;        // by a syntax error
+    char *output;
+    size_t outputSize;
+    char *diagnostics;  // for stderr; only outside TEXT_OUTPUT, where they are not in output
+    size_t diagnosticsSize;
+} CHUNK;
+
+typedef struct batch {
+    CHUNK *chunks;
+    int chunkCount;
+    int window;
+    int written;        // chunks written to stdout, all of them in order
+    int nextParallel;   // the first chunk no worker has taken
+    bool stop;
+    FILE *readTarget;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} BATCH;
+
+static bool isWordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+// whether text[start, *end) is one of the functions whose order matters;
+// words are read as the lexer reads symbols, which start with a letter
+static bool isSerialWord(char *text, size_t start, size_t length, size_t *end)
+{
+    size_t i = start;
+
+    while (i < length && isWordChar(text[i]))
+    {
+        i++;
+    }
+    *end = i;
+    return i - start == 4 && (memcmp(text + start, "read", 4) == 0 || memcmp(text + start, "rand", 4) == 0);
+}
+
+static void addChunk(CHUNK **chunks, int *count, int *capacity, char *text, size_t length, bool serial)
+{
+    if (*count == *capacity)
+    {
+        *capacity = *capacity ? 2 * *capacity : 64;
+        if ((*chunks = realloc(*chunks, *capacity * sizeof(CHUNK))) == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+    (*chunks)[(*count)++] = (CHUNK) {.text = text, .length = length, .serial = serial};
+}
+
+// Cuts text after each newline at depth zero, then joins the lines into
+// chunks of about chunkSize, starting a new chunk wherever the lines switch
+// between serial and not. An unbalanced parenthesis only makes a chunk
+// longer: it is still parsed as a whole, and fails where one parse would.
+static int splitChunks(char *text, size_t length, size_t chunkSize, CHUNK **chunks)
+{
+    int count = 0;
+    int capacity = 0;
+    size_t chunkStart = 0;
+    size_t lineStart = 0;
+    bool chunkSerial = false;
+    bool lineSerial = false;
+    int depth = 0;
+
+    *chunks = NULL;
+    for (size_t i = 0; i < length;)
+    {
+        char c = text[i];
+
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$')
+        {
+            lineSerial = isSerialWord(text, i, length, &i) || lineSerial;
+            continue;
+        }
+
+        i++;
+        if (c == '(')
+        {
+            depth++;
+        }
+        else if (c == ')')
+        {
+            depth--;
+        }
+        else if (c == '\n' && depth <= 0)
+        {
+            if (lineSerial != chunkSerial && lineStart > chunkStart)
+            {
+                addChunk(chunks, &count, &capacity, text + chunkStart, lineStart - chunkStart, chunkSerial);
+                chunkStart = lineStart;
+            }
+            chunkSerial = lineSerial;
+            if (i - chunkStart >= chunkSize)
+            {
+                addChunk(chunks, &count, &capacity, text + chunkStart, i - chunkStart, chunkSerial);
+                chunkStart = i;
+            }
+            lineStart = i;
+            lineSerial = false;
+            depth = 0;
+        }
+    }
+
+    // the last line need not end in a newline
+    if (lineSerial != chunkSerial && lineStart > chunkStart)
+    {
+        addChunk(chunks, &count, &capacity, text + chunkStart, lineStart - chunkStart, chunkSerial);
+        chunkStart = lineStart;
+        chunkSerial = lineSerial;
+    }
+    if (length > chunkStart)
+    {
+        addChunk(chunks, &count, &capacity, text + chunkStart, length - chunkStart, chunkSerial || lineSerial);
+    }
+    return count;
+}
+
+// parses and evaluates one chunk, collecting everything it writes
+static void evalChunk(PARSER *parser, CHUNK *chunk)
+{
+    if ((thread_output = open_memstream(&chunk->output, &chunk->outputSize)) == NULL
+        || (output_format != TEXT_OUTPUT
+            && (parser->diagnostics = open_memstream(&chunk->diagnostics, &chunk->diagnosticsSize)) == NULL))
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    scanText(parser, chunk->text, chunk->length);
+    chunk->failed = yyparse(parser) != 0;
+    chunk->stopped = chunk->failed || parser->ended;
+
+    fclose(thread_output);
+    thread_output = NULL;
+    if (parser->diagnostics != NULL)
+    {
+        fclose(parser->diagnostics);
+        parser->diagnostics = NULL;
+    }
+}
+
+// The next chunk for a lane to run, waiting while it is a window or more
+// ahead of the writer; -1 when there is none. Called with the lock held.
+static int takeChunk(BATCH *batch, int *next, bool serial)
+{
+    while (true)
+    {
+        while (*next < batch->chunkCount && batch->chunks[*next].serial != serial)
+        {
+            (*next)++;
+        }
+        if (batch->stop || *next == batch->chunkCount)
+        {
+            return -1;
+        }
+        if (*next < batch->written + batch->window)
+        {
+            return (*next)++;
+        }
+        pthread_cond_wait(&batch->changed, &batch->lock);
+    }
+}
+
+static void runLane(BATCH *batch, int *next, bool serial)
+{
+    PARSER *parser = createParser(NULL, batch->readTarget);
+    int index;
+
+    pthread_mutex_lock(&batch->lock);
+    while ((index = takeChunk(batch, next, serial)) >= 0)
+    {
+        pthread_mutex_unlock(&batch->lock);
+        evalChunk(parser, &batch->chunks[index]);
+        pthread_mutex_lock(&batch->lock);
+
+        batch->chunks[index].done = true;
+        pthread_cond_broadcast(&batch->changed);
+    }
+    pthread_mutex_unlock(&batch->lock);
+
+    freeParser(parser);
+}
+
+static void *parallelLane(void *batch)
+{
+    runLane(batch, &((BATCH *) batch)->nextParallel, false);
+    return NULL;
+}
+
+// only this thread ever takes serial chunks, so they run one after another
+static void *serialLane(void *batch)
+{
+    int next = 0;
+    runLane(batch, &next, true);
+    return NULL;
+}
+
+int evalBatch(char *text, size_t length, FILE *readTarget, int jobs)
+{
+    BATCH batch = {.window = WINDOW_PER_JOB * jobs, .readTarget = readTarget};
+    pthread_t *workers;
+    int status = EXIT_SUCCESS;
+
+    size_t chunkSize = length / ((size_t) jobs * CHUNKS_PER_JOB);
+    chunkSize = chunkSize < MIN_CHUNK_SIZE ? MIN_CHUNK_SIZE : chunkSize > MAX_CHUNK_SIZE ? MAX_CHUNK_SIZE : chunkSize;
+    batch.chunkCount = splitChunks(text, length, chunkSize, &batch.chunks);
+
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.changed, NULL);
+    if ((workers = malloc((jobs + 1) * sizeof(pthread_t))) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    for (int i = 0; i < jobs; i++)
+    {
+        pthread_create(&workers[i], NULL, parallelLane, &batch);
+    }
+    pthread_create(&workers[jobs], NULL, serialLane, &batch);
+
+    // the reorder buffer: each chunk is written once all before it have been
+    for (int i = 0; i < batch.chunkCount; i++)
+    {
+        CHUNK *chunk = &batch.chunks[i];
+
+        pthread_mutex_lock(&batch.lock);
+        while (!chunk->done)
+        {
+            pthread_cond_wait(&batch.changed, &batch.lock);
+        }
+        pthread_mutex_unlock(&batch.lock);
+
+        fwrite(chunk->diagnostics, 1, chunk->diagnosticsSize, stderr);
+        fwrite(chunk->output, 1, chunk->outputSize, stdout);
+        free(chunk->diagnostics);
+        free(chunk->output);
+
+        pthread_mutex_lock(&batch.lock);
+        batch.written = i + 1;
+        batch.stop = chunk->stopped;
+        pthread_cond_broadcast(&batch.changed);
+        pthread_mutex_unlock(&batch.lock);
+
+        if (chunk->stopped)
+        {
+            status = chunk->failed ? EXIT_FAILURE : EXIT_SUCCESS;
+            break;
+        }
+    }
+
+    for (int i = 0; i <= jobs; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    for (int i = batch.written; i < batch.chunkCount; i++)
+    {
+        free(batch.chunks[i].diagnostics);
+        free(batch.chunks[i].output);
+    }
+
+    free(workers);
+    free(batch.chunks);
+    pthread_mutex_destroy(&batch.lock);
+    pthread_cond_destroy(&batch.changed);
+    return status;
+}
@@ -0,0 +1,473 @@
+#include "cilisp.h"
+#include <time.h>
+
+// bench:
+// Micro-benchmarks for the lexer, the parser and every builtin, built by the
+// bench script into one program with the interpreter's own main left out.
+// Each benchmark repeats one operation until it has run for a while and
+// reports the mean time and the heap allocations per operation.
+//
+//   lex       yylex over one line
+//   parse     yyparse of one line, building its tree and dropping it unevaluated
+//   eval      yyparse of one line as the interpreter runs it: parsed, evaluated and printed
+//   run       run() of bytecode compiled once from the same expression
+//
+// The synthetic inputs scale: wide operand lists, deep nesting, long chains
+// of let bindings and recursive lambdas. The report goes to stderr; anything
+// the interpreter prints while being measured goes to /dev/null. Pass a
+// substring to run only the benchmarks whose names contain it.
+
+#define MIN_SECONDS 0.2
+#define MAX_ITERATIONS (1L << 30)
+#define READ_LINES 65536
+
+// The bench script links with --wrap for these, so every heap allocation
+// the interpreter makes, including flex's and bison's, is counted here.
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+static long allocations;
+
+void *__wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size)
+{
+    allocations++;
+    return __real_realloc(pointer, size);
+}
+
+static double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+static char *filter;
+static PARSER *parser;      // the lex, parse and eval benchmarks', which also builds the run benchmarks' trees
+static VM *vm;              // the run benchmarks', apart from the parser's
+
+static void measure(char *name, void (*operation)(void *), void *input)
+{
+    long iterations = 1;
+    long allocated;
+    double elapsed;
+
+    if (filter && !strstr(name, filter))
+    {
+        return;
+    }
+
+    // double the repetitions until one batch is long enough to time
+    while (true)
+    {
+        allocated = allocations;
+        double start = now();
+        for (long i = 0; i < iterations; i++)
+        {
+            operation(input);
+        }
+        elapsed = now() - start;
+        allocated = allocations - allocated;
+
+        if (elapsed >= MIN_SECONDS || iterations >= MAX_ITERATIONS)
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    fprintf(stderr, "%-32s %14.1f ns/op %10.2f allocs/op\n",
+            name, elapsed * 1e9 / (double) iterations, (double) allocated / (double) iterations);
+}
+
+
+// Source text of one line, with the two NULs yy_scan_buffer needs after it.
+typedef struct text {
+    char *chars;
+    size_t length;
+    size_t capacity;
+} TEXT;
+
+static void append(TEXT *text, char *format, ...)
+{
+    va_list args;
+
+    while (true)
+    {
+        va_start(args, format);
+        size_t room = text->capacity - text->length;
+        int written = vsnprintf(text->chars + text->length, room, format, args);
+        va_end(args);
+
+        // keep room for the terminating NULs
+        if (written >= 0 && (size_t) written + 2 < room)
+        {
+            text->length += written;
+            return;
+        }
+
+        text->capacity = text->capacity ? 2 * text->capacity : 256;
+        if ((text->chars = realloc(text->chars, text->capacity)) == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+}
+
+// ends the line; the length then covers both NULs, as yy_scan_buffer expects
+static TEXT *finish(TEXT *text)
+{
+    append(text, "\n");
+    text->chars[text->length++] = '\0';
+    text->chars[text->length++] = '\0';
+    return text;
+}
+
+static void lexText(void *input)
+{
+    TEXT *text = input;
+    YY_BUFFER_STATE buffer = yy_scan_buffer(text->chars, text->length, parser->scanner);
+    YYSTYPE value;
+
+    int token;
+    do
+    {
+        token = yylex(&value, parser->scanner);
+    } while (token != 0 && token != EOFT);
+
+    yy_delete_buffer(buffer, parser->scanner);
+}
+
+static void parseLine(TEXT *text, bool parseOnly)
+{
+    YY_BUFFER_STATE buffer = yy_scan_buffer(text->chars, text->length, parser->scanner);
+
+    parser->parseOnly = parseOnly;
+    yyparse(parser);
+
+    yy_delete_buffer(buffer, parser->scanner);
+}
+
+static void parseText(void *input)
+{
+    parseLine(input, true);
+}
+
+static void evalText(void *input)
+{
+    // as in runBytecode, (read) must not run out of numbers and time the warning instead
+    if (readTargetEnded(parser->vm->reader))
+    {
+        rewindReadTarget(parser->vm->reader);
+    }
+    parseLine(input, false);
+}
+
+static void runBytecode(void *input)
+{
+    // (read) would otherwise run out of numbers partway through a batch
+    if (readTargetEnded(vm->reader))
+    {
+        rewindReadTarget(vm->reader);
+    }
+    run(vm, input);
+}
+
+
+// Builders for the ASTs the run benchmarks compile, in the parser's arena.
+static AST_NODE *integer(int64_t value)
+{
+    return createNumberNode(parser, INT_RET_VAL(value));
+}
+
+static AST_NODE *real(double value)
+{
+    return createNumberNode(parser, DOUBLE_RET_VAL(value));
+}
+
+static AST_NODE *symbol(char *name)
+{
+    return createSymbolNode(parser, intern(&parser->atoms, name, strlen(name)));
+}
+
+static AST_NODE *call(FUNC_TYPE func, int count, AST_NODE **operands)
+{
+    AST_NODE *opList = NULL;
+    while (count-- > 0)
+    {
+        opList = addExpressionToList(operands[count], opList);
+    }
+    return createFunctionNode(parser, func, opList);
+}
+
+static AST_NODE *call2(FUNC_TYPE func, AST_NODE *first, AST_NODE *second)
+{
+    AST_NODE *operands[] = {first, second};
+    return call(func, 2, operands);
+}
+
+static AST_NODE *callLambda(char *name, AST_NODE *first, AST_NODE *second)
+{
+    AST_NODE *opList = addExpressionToList(first, second ? addExpressionToList(second, NULL) : NULL);
+    return createCustomFunctionNode(parser, intern(&parser->atoms, name, strlen(name)), opList);
+}
+
+// (name lambda (first [second]) body)
+static SYMBOL_TABLE_NODE *lambda(char *name, char *first, char *second, AST_NODE *body)
+{
+    SYMBOL_TABLE_NODE *args = second ? createArgTable(parser, intern(&parser->atoms, second, strlen(second)), NULL) : NULL;
+    args = createArgTable(parser, intern(&parser->atoms, first, strlen(first)), args);
+    return createFunctionTableNode(parser, NO_TYPE, intern(&parser->atoms, name, strlen(name)), args, body);
+}
+
+// compiles node the way eval() does, minus folding, so run() still does the work
+static BYTECODE *compiled(AST_NODE *node)
+{
+    resolve(node);
+    infer(node);
+    BYTECODE *bytecode = compile(node);
+    arenaReset(&parser->arena);
+    return bytecode;
+}
+
+
+// One expression in both forms: source text for lex and parse, bytecode for run.
+typedef struct input {
+    TEXT text;
+    BYTECODE *bytecode;
+} INPUT;
+
+static void measureInput(char *name, INPUT *input)
+{
+    char label[128];
+
+    snprintf(label, sizeof(label), "lex/%s", name);
+    measure(label, lexText, &input->text);
+    snprintf(label, sizeof(label), "parse/%s", name);
+    measure(label, parseText, &input->text);
+    snprintf(label, sizeof(label), "eval/%s", name);
+    measure(label, evalText, &input->text);
+    snprintf(label, sizeof(label), "run/%s", name);
+    measure(label, runBytecode, input->bytecode);
+
+    freeBytecode(input->bytecode);
+    free(input->text.chars);
+}
+
+// (func a b) on two ints or two doubles, with as many operands as func takes
+static void benchBuiltin(FUNC_TYPE func, NUM_TYPE type)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    AST_NODE *operands[2];
+    int count = funcInfo[func].minOperands;
+    char name[64];
+
+    if (count < 2 && (funcInfo[func].maxOperands == VARIADIC || funcInfo[func].maxOperands >= 2))
+    {
+        count = 2;
+    }
+
+    append(&input.text, "(%s", funcNames[func]);
+    for (int i = 0; i < count; i++)
+    {
+        if (type == INT_TYPE)
+        {
+            append(&input.text, " %d", 7 - 5 * i);
+            operands[i] = integer(7 - 5 * i);
+        }
+        else
+        {
+            append(&input.text, " %.1f", 7.5 - 5 * i);
+            operands[i] = real(7.5 - 5 * i);
+        }
+    }
+    append(&input.text, ")");
+    finish(&input.text);
+    input.bytecode = compiled(call(func, count, operands));
+
+    if (count == 0)
+    {
+        snprintf(name, sizeof(name), "%s", funcNames[func]);
+    }
+    else
+    {
+        snprintf(name, sizeof(name), "%s/%s", funcNames[func], type == INT_TYPE ? "int" : "double");
+    }
+    measureInput(name, &input);
+}
+
+// (add 1 2 ... n)
+static void benchWide(int n)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    AST_NODE **operands = malloc(n * sizeof(AST_NODE *));
+    char name[64];
+
+    append(&input.text, "(add");
+    for (int i = 0; i < n; i++)
+    {
+        append(&input.text, " %d", i + 1);
+        operands[i] = integer(i + 1);
+    }
+    append(&input.text, ")");
+    finish(&input.text);
+    input.bytecode = compiled(call(ADD_FUNC, n, operands));
+    free(operands);
+
+    snprintf(name, sizeof(name), "wide/%d", n);
+    measureInput(name, &input);
+}
+
+// (add 1 (add 1 ... (add 1 1)))
+static void benchDeep(int n)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    AST_NODE *node = integer(1);
+    char name[64];
+
+    for (int i = 0; i < n; i++)
+    {
+        append(&input.text, "(add 1 ");
+        node = call2(ADD_FUNC, integer(1), node);
+    }
+    append(&input.text, "1");
+    for (int i = 0; i < n; i++)
+    {
+        append(&input.text, ")");
+    }
+    finish(&input.text);
+    input.bytecode = compiled(node);
+
+    snprintf(name, sizeof(name), "deep/%d", n);
+    measureInput(name, &input);
+}
+
+// ((let (x0 0) (x1 (add x0 1)) ... ) xn-1), which forces every binding
+static void benchLets(int n)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    BINDING_LIST *table = createBindingList(parser);
+    char id[32];
+    char previous[32];
+    char name[64];
+
+    append(&input.text, "((let");
+    for (int i = 0; i < n; i++)
+    {
+        snprintf(id, sizeof(id), "x%d", i);
+        AST_NODE *value = integer(0);
+        if (i == 0)
+        {
+            append(&input.text, " (%s 0)", id);
+        }
+        else
+        {
+            append(&input.text, " (%s (add %s 1))", id, previous);
+            value = call2(ADD_FUNC, symbol(previous), integer(1));
+        }
+        addToLetList(parser, table, createVariableTableNode(parser, NO_TYPE, intern(&parser->atoms, id, strlen(id)), value));
+        strcpy(previous, id);
+    }
+    append(&input.text, ") %s)", previous);
+    finish(&input.text);
+    input.bytecode = compiled(createScopeNode(parser, table->head, symbol(previous)));
+
+    snprintf(name, sizeof(name), "lets/%d", n);
+    measureInput(name, &input);
+}
+
+// a tail-recursive lambda summing 1..n
+static void benchLoop(int n)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    char name[64];
+
+    append(&input.text, "((let (f lambda (n acc) (cond (less n 1) acc (f (sub n 1) (add acc n))))) (f %d 0))", n);
+    finish(&input.text);
+
+    AST_NODE *body = createCondNode(parser, call2(LESS_FUNC, symbol("n"), integer(1)),
+                                    symbol("acc"),
+                                    callLambda("f", call2(SUB_FUNC, symbol("n"), integer(1)),
+                                               call2(ADD_FUNC, symbol("acc"), symbol("n"))));
+    input.bytecode = compiled(createScopeNode(parser, lambda("f", "n", "acc", body), callLambda("f", integer(n), integer(0))));
+
+    snprintf(name, sizeof(name), "loop/%d", n);
+    measureInput(name, &input);
+}
+
+// the doubly recursive fibonacci of n
+static void benchFib(int n)
+{
+    INPUT input = {{NULL, 0, 0}, NULL};
+    char name[64];
+
+    append(&input.text, "((let (fib lambda (n) (cond (less n 2) n (add (fib (sub n 1)) (fib (sub n 2)))))) (fib %d))", n);
+    finish(&input.text);
+
+    AST_NODE *body = createCondNode(parser, call2(LESS_FUNC, symbol("n"), integer(2)),
+                                    symbol("n"),
+                                    call2(ADD_FUNC,
+                                          callLambda("fib", call2(SUB_FUNC, symbol("n"), integer(1)), NULL),
+                                          callLambda("fib", call2(SUB_FUNC, symbol("n"), integer(2)), NULL)));
+    input.bytecode = compiled(createScopeNode(parser, lambda("fib", "n", NULL, body), callLambda("fib", integer(n), NULL)));
+
+    snprintf(name, sizeof(name), "fib/%d", n);
+    measureInput(name, &input);
+}
+
+int main(int argc, char **argv)
+{
+    filter = argc > 1 ? argv[1] : NULL;
+    // measure what large runs do, not the interactive prompts and flushes
+    batch_mode = true;
+
+    if (!freopen("/dev/null", "w", stdout))
+    {
+        fprintf(stderr, "Cannot open /dev/null!\n");
+        return EXIT_FAILURE;
+    }
+
+    // numbers for (read)
+    FILE *read_target = tmpfile();
+    for (int i = 0; i < READ_LINES; i++)
+    {
+        fprintf(read_target, "%d\n", i);
+    }
+    rewind(read_target);
+    parser = createParser(NULL, read_target);
+    vm = createVM(read_target, false);
+
+    for (FUNC_TYPE func = NEG_FUNC; func < CUSTOM_FUNC; func++)
+    {
+        benchBuiltin(func, INT_TYPE);
+        if (funcInfo[func].minOperands > 0)
+        {
+            benchBuiltin(func, DOUBLE_TYPE);
+        }
+    }
+
+    int sizes[] = {10, 100, 1000};
+    for (int i = 0; i < 3; i++)
+    {
+        benchWide(sizes[i]);
+        benchDeep(sizes[i]);
+        benchLets(sizes[i]);
+        benchLoop(sizes[i] * 100);
+    }
+    benchFib(10);
+    benchFib(20);
+
+    return EXIT_SUCCESS;
+}
@@ -4,13 +4,38 @@
 #define RED             "\033[31m"
 #define RESET_COLOR     "\033[0m"
 
+bool batch_mode;
+int fork_jobs;
+OUTPUT_FORMAT output_format;
+_Thread_local FILE *thread_output;
+
+FILE *resultStream()
+{
+    return thread_output != NULL ? thread_output : stdout;
+}
+
+// the text of yyerror and of parseError when the parser has no stream of its
+// own; in TEXT_OUTPUT it goes to results, which is stdout or a batch worker's output
+static void printError(FILE *results, const char *message)
+{
+    if (output_format == TEXT_OUTPUT)
+    {
+        fprintf(results, RED "\nERROR: %s\nExiting...\n" RESET_COLOR, message);
+        fflush(results);
+    }
+    else
+    {
+        fprintf(stderr, "ERROR: %s\nExiting...\n", message);
+    }
+}
+
 // yyerror:
 // Something went so wrong that the whole program should crash.
 // You should basically never call this unless an allocation fails.
 // (see the "yyerror("Memory allocation failed!")" calls and do the same.
 // This is basically printf, but red, with "\nERROR: " prepended, "\n" appended,
 // and an "exit(1);" at the end to crash the program.
-// It's called "yyerror" instead of "error" so the parser will use it for errors too.
+// The parser reports syntax errors through parseError instead, which does not exit.
 void yyerror(char *format, ...)
 {
     char buffer[256];
@@ -18,8 +43,7 @@ void yyerror(char *format, ...)
     va_start (args, format);
     vsnprintf (buffer, 255, format, args);
 
-    printf(RED "\nERROR: %s\nExiting...\n" RESET_COLOR, buffer);
-    fflush(stdout);
+    printError(stdout, buffer);
 
     va_end (args);
     exit(1);
@@ -42,46 +66,98 @@ void warning(char *format, ...)
     va_start (args, format);
     vsnprintf (buffer, 255, format, args);
 
-    printf(RED "WARNING: %s\n" RESET_COLOR, buffer);
-    fflush(stdout);
+    if (output_format != TEXT_OUTPUT)
+    {
+        fprintf(stderr, "WARNING: %s\n", buffer);
+    }
+    else
+    {
+        fprintf(resultStream(), RED "WARNING: %s\n" RESET_COLOR, buffer);
+        if (!batch_mode)
+        {
+            fflush(stdout);
+        }
+    }
+
+    va_end (args);
+}
+
+// parseWarning:
+// A warning about the input one parser is reading. It goes to the parser's
+// diagnostics stream, in a single write so it cannot be split by another
+// thread's, or where warning() writes if the parser has none.
+void parseWarning(PARSER *parser, char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start (args, format);
+    vsnprintf (buffer, 255, format, args);
+
+    if (parser->diagnostics == NULL)
+    {
+        warning("%s", buffer);
+    }
+    else
+    {
+        fprintf(parser->diagnostics, "WARNING: %s\n", buffer);
+    }
 
     va_end (args);
 }
 
+// parseError:
+// The parser's yyerror. A syntax error ends only the parse it is found in:
+// it is reported like parseWarning, counted, and yyparse returns 1, so the
+// other parsers and the caller carry on.
+void parseError(PARSER *parser, const char *message)
+{
+    parser->errorCount++;
+
+    if (parser->diagnostics == NULL)
+    {
+        printError(resultStream(), message);
+    }
+    else
+    {
+        fprintf(parser->diagnostics, "ERROR: %s\nExiting...\n", message);
+    }
+}
+
+// Array of string values for function names.
+// Must be in sync with members of the FUNC_TYPE enum in order for resolveFunc to work.
+// For example, funcNames[NEG_FUNC] should be "neg"
+char *funcNames[] = {
+        "neg",
+        "abs",
+        "add",
+        "sub",
+        "mult",
+        "div",
+        "remainder",
+        "exp",
+        "exp2",
+        "pow",
+        "log",
+        "sqrt",
+        "cbrt",
+        "hypot",
+        "max",
+        "min",
+        "rand",
+        "read",
+        "equal",
+        "less",
+        "greater",
+        "print",
+        "custom",
+
+        // TODO complete the array
+        // the empty string below must remain the last element
+        ""
+};
+
 FUNC_TYPE resolveFunc(char *funcName)
 {
-    // Array of string values for function names.
-    // Must be in sync with members of the FUNC_TYPE enum in order for resolveFunc to work.
-    // For example, funcNames[NEG_FUNC] should be "neg"
-    char *funcNames[] = {
-            "neg",
-            "abs",
-            "add",
-            "sub",
-            "mult",
-            "div",
-            "remainder",
-            "exp",
-            "exp2",
-            "pow",
-            "log",
-            "sqrt",
-            "cbrt",
-            "hypot",
-            "max",
-            "min",
-            "rand",
-            "read",
-            "equal",
-            "less",
-            "greater",
-            "print",
-            "custom",
-
-            // TODO complete the array
-            // the empty string below must remain the last element
-            ""
-    };
     int i = 0;
     while (funcNames[i][0] != '\0')
     {
@@ -100,40 +176,41 @@ NUM_TYPE resolveType(char * type)
     else if(strcmp(type, "double") == 0) return 1;
 }
 
-AST_NODE *createNumberNode(double value, NUM_TYPE type)
+double toDouble(RET_VAL number)
+{
+    return number.type == INT_TYPE ? (double) number.ival : number.value;
+}
+
+bool isZero(RET_VAL number)
+{
+    return number.type == INT_TYPE ? number.ival == 0 : number.value == 0;
+}
+
+AST_NODE *createNumberNode(PARSER *parser, AST_NUMBER number)
 {
     AST_NODE *node;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    node = arenaAlloc(&parser->arena, nodeSize);
 
     // TODO complete the function finished
     // Populate "node", the AST_NODE * created above with the argument data.
     // node is a generic AST_NODE, don't forget to specify it is of type NUMBER_NODE
-    node->data.number.value = value;
-    node->data.number.type = type;
+    node->data.number = number;
     node->type = NUM_NODE_TYPE;
 
     return node;
 }
 
 
-AST_NODE *createFunctionNode(FUNC_TYPE func, AST_NODE *opList)
+AST_NODE *createFunctionNode(PARSER *parser, FUNC_TYPE func, AST_NODE *opList)
 {
     AST_NODE *node;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    node = arenaAlloc(&parser->arena, nodeSize);
 
     // TODO complete the function finished
     // Populate the allocated AST_NODE *node's data
@@ -149,21 +226,18 @@ AST_NODE *createFunctionNode(FUNC_TYPE func, AST_NODE *opList)
     return node;
 }
 
-AST_NODE *createCustomFunctionNode(char *id, AST_NODE *opList)
+AST_NODE *createCustomFunctionNode(PARSER *parser, ATOM *id, AST_NODE *opList)
 {
     AST_NODE *node;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    node = arenaAlloc(&parser->arena, nodeSize);
 
     // TODO complete the function finished
     // Populate the allocated AST_NODE *node's data
     node->type = FUNC_NODE_TYPE;
+    node->data.function.id = id;
     node->data.function.func = CUSTOM_FUNC;
     node->data.function.opList = opList;
     while(opList != NULL)
@@ -182,17 +256,32 @@ AST_NODE *addExpressionToList(AST_NODE *newExpr, AST_NODE *exprList)
     return newExpr;
 }
 
-AST_NODE *createSymbolNode(char *id)
+EXPRESSION_LIST *createExpressionList(PARSER *parser)
+{
+    return arenaAlloc(&parser->arena, sizeof(EXPRESSION_LIST));
+}
+
+EXPRESSION_LIST *appendExpression(EXPRESSION_LIST *exprList, AST_NODE *newExpr)
+{
+    if (exprList->tail)
+    {
+        exprList->tail->next = newExpr;
+    }
+    else
+    {
+        exprList->head = newExpr;
+    }
+    exprList->tail = newExpr;
+    return exprList;
+}
+
+AST_NODE *createSymbolNode(PARSER *parser, ATOM *id)
 {
     AST_NODE *node;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE) + sizeof(AST_SYMBOL);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    node = arenaAlloc(&parser->arena, nodeSize);
 
     node->type = SYM_NODE_TYPE;
     node->data.symbol.id = id;
@@ -200,17 +289,13 @@ AST_NODE *createSymbolNode(char *id)
     return node;
 }
 
-AST_NODE *createScopeNode(SYMBOL_TABLE_NODE *let_section, AST_NODE *s_expr)
+AST_NODE *createScopeNode(PARSER *parser, SYMBOL_TABLE_NODE *let_section, AST_NODE *s_expr)
 {
     AST_NODE *scopeNode;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE);
-    if ((scopeNode = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    scopeNode = arenaAlloc(&parser->arena, nodeSize);
 
     scopeNode->type = SCOPE_NODE_TYPE;
     s_expr->parent = scopeNode;
@@ -227,17 +312,13 @@ AST_NODE *createScopeNode(SYMBOL_TABLE_NODE *let_section, AST_NODE *s_expr)
     return scopeNode;
 }
 
-AST_NODE *createCondNode(AST_NODE *condition, AST_NODE *trueValue, AST_NODE *falseValue)
+AST_NODE *createCondNode(PARSER *parser, AST_NODE *condition, AST_NODE *trueValue, AST_NODE *falseValue)
 {
     AST_NODE *cond;
     size_t nodeSize;
 
     nodeSize = sizeof(AST_NODE);
-    if ((cond = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
+    cond = arenaAlloc(&parser->arena, nodeSize);
 
     cond->type = COND_NODE_TYPE;
     cond->data.conditional.condition = condition;
@@ -250,966 +331,242 @@ AST_NODE *createCondNode(AST_NODE *condition, AST_NODE *trueValue, AST_NODE *fal
     return cond;
 }
 
-// add symbol to the list
-SYMBOL_TABLE_NODE *let_list(SYMBOL_TABLE_NODE *let_elem, SYMBOL_TABLE_NODE *let_list)
+BINDING_LIST *createBindingList(PARSER *parser)
 {
-    SYMBOL_TABLE_NODE *table = let_list;
-
-    int redeclaration = 0;
-    while(table)
-    {
-        if(strcmp(let_elem->id, table->id) == 0)
-        {
-            warning("Duplicate assignment to symbol \"%s\" detected in the same scope!\n"
-                    "Only the first assignment is kept!", table->id);
-            redeclaration = 1;
-            let_list = let_elem;    // let_list takes the value of the head of the let_elem
-            break;
-        }
-        table = table->next;
-    }
-
-    // if it is not a redeclaration, place the symbol at the front of the let_list
-    if(!redeclaration)
-        let_elem->next = let_list;
-
-    return let_elem;
+    return arenaAlloc(&parser->arena, sizeof(BINDING_LIST));
 }
 
-// create symbol table node with data
-SYMBOL_TABLE_NODE *createVariableTableNode(NUM_TYPE type, char *id, AST_NODE *s_expr)
+static void appendBinding(BINDING_LIST *list, SYMBOL_TABLE_NODE *binding)
 {
-    SYMBOL_TABLE_NODE *symbolTableNode;
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((symbolTableNode = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    symbolTableNode->id = id;
-    symbolTableNode->value = s_expr;
-    symbolTableNode->type = type;
-    symbolTableNode->symbolType = VAR_TYPE;
-
-    return symbolTableNode;
-}
-
-SYMBOL_TABLE_NODE *createFunctionTableNode( NUM_TYPE type, char *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr)
-{
-    SYMBOL_TABLE_NODE *symbolTableNode;
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((symbolTableNode = calloc(nodeSize, 1)) == NULL)
+    binding->next = NULL;
+    if (list->tail)
     {
-        yyerror("Memory allocation failed!");
-        exit(1);
+        list->tail->next = binding;
     }
-
-    symbolTableNode->id = id;
-    symbolTableNode->value = s_expr;
-    s_expr->symbolTable = arg_list;
-    symbolTableNode->type = type;
-    symbolTableNode->symbolType = LAMBDA_TYPE;
-
-    return symbolTableNode;
-}
-
-SYMBOL_TABLE_NODE *createArgTable(char *id, SYMBOL_TABLE_NODE *arg_list)
-{
-    SYMBOL_TABLE_NODE *table;
-
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((table = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    table->id = id;
-    table->type = NO_TYPE;
-    table->symbolType = ARG_TYPE;
-    table->next = arg_list;
-
-    return table;
-}
-
-RET_VAL evalNeg(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Neg function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("neg called with extra (ignored) operands!");
-    }
-
-    RET_VAL result;
-    result = eval(node);
-    result.value = -result.value;
-    result.type = result.type;
-    return result;
-
-}
-
-RET_VAL evalAbs(AST_NODE *node)
-{
-
-    if(!node)
-    {
-        warning("No operands in Neg function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Too many operands in Abs function");
-
-    }
-    RET_VAL result;
-    result.value = 0, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = fabs(result.value);
-    result.type = result.type;
-    return result;
-}
-
-RET_VAL evalAdd(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 0, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(node == NULL)
-    {
-        warning("Add called with no operands! 0 returned!");
-        result.type = INT_TYPE;
-        return result;
-    }
-
-
-    while(node != NULL)
+    else
     {
-        result2 = eval(node);
-
-        result.value += result2.value;
-        if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-            result.type = DOUBLE_TYPE;
-        else
-            result.type = INT_TYPE;
-
-        node = node->next;
+        list->head = binding;
     }
-
-    return result;
+    list->tail = binding;
 }
 
-
-RET_VAL evalSub(AST_NODE *node)
+// variables and lambdas are looked up separately, so they may share a name
+static bool sameName(SYMBOL_TABLE_NODE *a, SYMBOL_TABLE_NODE *b)
 {
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 0, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-    if(!node)
-    {
-        warning("No operands in Sub function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: Sub called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning("Sub called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-    result.value -= result2.value;
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-
-
-
+    return a->id == b->id && (a->symbolType == LAMBDA_TYPE) == (b->symbolType == LAMBDA_TYPE);
 }
 
-// TODO - DEBUGGING REQUIRED - DOES NOT PRINT RIGHT NUM_TYPE IN SPECIFIC CIRCUMSTANCES
-RET_VAL evalMult(AST_NODE *node)
+// the entry of list's name set that binding's name belongs in
+static SYMBOL_TABLE_NODE **nameSlot(BINDING_LIST *list, SYMBOL_TABLE_NODE *binding)
 {
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
+    unsigned int mask = (unsigned int) list->nameCapacity - 1;
+    unsigned int index = (binding->id->hash * 2 + (binding->symbolType == LAMBDA_TYPE)) & mask;
 
-
-    if(node == NULL)
+    while (list->names[index] != NULL && !sameName(list->names[index], binding))
     {
-        warning("Mult called with no operands! 1 returned!");
-        result.type = INT_TYPE;
-        return result;
+        index = (index + 1) & mask;
     }
-
-    while(node != NULL)
-    {
-        result2 = eval(node);
-
-        result.value *= result2.value;
-        if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-            result.type = DOUBLE_TYPE;
-        else
-            result.type = INT_TYPE;
-        node = node->next;
-
-    }
-
-    return result;
+    return &list->names[index];
 }
 
-RET_VAL evalDiv(AST_NODE *node)
+// keeps the set at most half full; the old table stays in the arena until the expression is done
+static void growNames(PARSER *parser, BINDING_LIST *list)
 {
-    RET_VAL result;
-    RET_VAL result2;
+    SYMBOL_TABLE_NODE **old = list->names;
+    int oldCapacity = list->nameCapacity;
 
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in div function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: div called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
+    if (2 * (list->nameCount + 1) <= list->nameCapacity)
     {
-        warning("Sub called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-
-    if(result2.value == 0)
-    {
-        warning("You cannot divide by zero!");
-        return NAN_RET_VAL;
+        return;
     }
 
-    if(result.type == INT_TYPE && result2.type == INT_TYPE)
+    list->nameCapacity = oldCapacity ? 2 * oldCapacity : 8;
+    list->names = arenaAlloc(&parser->arena, list->nameCapacity * sizeof(SYMBOL_TABLE_NODE *));
+    for (int i = 0; i < oldCapacity; i++)
     {
-        if(remainder(result.value, result2.value) != 0)
+        if (old[i] != NULL)
         {
-            result.value /= result2.value;
-            result.value = floor(result.value);
+            *nameSlot(list, old[i]) = old[i];
         }
-        else result.value /= result2.value;
-    }
-    else
-        result.value /= result2.value;
-
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-}
-
-RET_VAL evalRemainder(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in remainder function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: Remainder called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning("Remainder called with extra (ignored) operands!");
-    }
-    result = eval(node);
-    result2 = eval(node->next);
-    result.value = remainder(result.value, result2.value);
-    if (result.value < abs(result2.value) && result.value < 0)
-    {
-        result.value += abs(result2.value);
-    }
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-}
-
-RET_VAL evalExp(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Exp function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Exp called with extra (ignored) operands!");
-
-    }
-
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = exp(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-RET_VAL evalExp2(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Exp2 function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Exp2 called with extra (ignored) operands!");
-
     }
-
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = exp2(result.value);
-    if (node->data.number.value < 0)
-        result.type = DOUBLE_TYPE;
-//    else
-//        result->type = result->type;
-    return result;
 }
 
-RET_VAL evalPow(AST_NODE *node)
+// add symbol to the end of the list, unless the list already binds its name
+BINDING_LIST *addToLetList(PARSER *parser, BINDING_LIST *let_list, SYMBOL_TABLE_NODE *let_elem)
 {
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
+    growNames(parser, let_list);
 
-    if(!node)
-    {
-        warning("No operands in Pow function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
+    SYMBOL_TABLE_NODE **slot = nameSlot(let_list, let_elem);
+    if (*slot != NULL)
     {
-        warning("Pow called with no second operand!");
-        return NAN_RET_VAL;
+        parseWarning(parser, "Duplicate assignment to symbol \"%s\" detected in the same scope!\n"
+                "Only the first assignment is kept!", let_elem->id->name);
+        return let_list;
     }
-    else if(node->next->next)
-    {
-        warning(" Pow called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-    result.type = result.type || result2.type;
-    result.value = pow(result.value, result2.value);
 
-    return result;
+    *slot = let_elem;
+    let_list->nameCount++;
+    appendBinding(let_list, let_elem);
+    return let_list;
 }
 
-RET_VAL evalLog(AST_NODE *node)
+BINDING_LIST *addToArgList(PARSER *parser, BINDING_LIST *arg_list, ATOM *id)
 {
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in Log function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Log called with extra (ignored) operands!");
-
-    }
-    result = eval(node);
-    result.value = log(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
+    appendBinding(arg_list, createArgTable(parser, id, NULL));
+    return arg_list;
 }
 
-RET_VAL evalSqrt(AST_NODE *node)
+// create symbol table node with data
+SYMBOL_TABLE_NODE *createVariableTableNode(PARSER *parser, NUM_TYPE type, ATOM *id, AST_NODE *s_expr)
 {
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
+    SYMBOL_TABLE_NODE *symbolTableNode;
+    size_t nodeSize;
 
-    if(!node)
-    {
-        warning("No operands in Sqrt function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Sqrt called with extra (ignored) operands!");
+    nodeSize = sizeof(SYMBOL_TABLE_NODE);
+    symbolTableNode = arenaAlloc(&parser->arena, nodeSize);
 
-    }
+    symbolTableNode->id = id;
+    symbolTableNode->value = s_expr;
+    symbolTableNode->type = type;
+    symbolTableNode->symbolType = VAR_TYPE;
 
-    result = eval(node);
-    result.value = sqrt(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
+    return symbolTableNode;
 }
 
-RET_VAL evalCbrt(AST_NODE *node)
+SYMBOL_TABLE_NODE *createFunctionTableNode(PARSER *parser, NUM_TYPE type, ATOM *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr)
 {
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
+    SYMBOL_TABLE_NODE *symbolTableNode;
+    size_t nodeSize;
 
-    if(!node)
-    {
-        warning("No operands in Cbrt function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Cbrt called with extra (ignored) operands!");
+    nodeSize = sizeof(SYMBOL_TABLE_NODE);
+    symbolTableNode = arenaAlloc(&parser->arena, nodeSize);
 
-    }
+    symbolTableNode->id = id;
+    symbolTableNode->value = s_expr;
+    s_expr->symbolTable = arg_list;
+    symbolTableNode->type = type;
+    symbolTableNode->symbolType = LAMBDA_TYPE;
 
-    result = eval(node);
-    result.value = cbrt(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
+    return symbolTableNode;
 }
 
-RET_VAL evalHypot(AST_NODE *node)
+SYMBOL_TABLE_NODE *createArgTable(PARSER *parser, ATOM *id, SYMBOL_TABLE_NODE *arg_list)
 {
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = 0;
-
-    if(node == NULL)
-    {
-        warning("WARNING: No operands detected!");
-        return NAN_RET_VAL;
-    }
-
-
-    while(node != NULL)
-    {
-        result2 = eval(node);
-        result2.value = pow(result2.value, 2);
-        result.value += result2.value;
-
-        //printf("add %f", node->data.number.value);
-
-        node = node->next;
-    }
-    result.type = DOUBLE_TYPE;
-    result.value = sqrt(result.value);
+    SYMBOL_TABLE_NODE *table;
 
-    return result;
-}
+    size_t nodeSize;
 
-RET_VAL evalMax(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = -1000;
+    nodeSize = sizeof(SYMBOL_TABLE_NODE);
+    table = arenaAlloc(&parser->arena, nodeSize);
 
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    while(node != NULL)
-    {
-        result2 = eval(node);
-        if(result.value < result2.value)
-        {
-            result.value = result2.value;
-            result.type = result2.type;
-        }
+    table->id = id;
+    table->type = NO_TYPE;
+    table->symbolType = ARG_TYPE;
+    table->next = arg_list;
 
-        node = node->next;
-    }
-    return result;
+    return table;
 }
 
-RET_VAL evalMin(AST_NODE *node)
+static size_t textResult(RET_VAL val, char *line)
 {
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = 1000;
+    size_t length;
 
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    while(node != NULL)
+    switch (val.type)
     {
-        result2 = eval(node);
-        if(result.value > result2.value)
-        {
-            result.value = result2.value;
-            result.type = result2.type;
-        }
-
-        node = node->next;
+        case INT_TYPE:
+            memcpy(line, "Integer : ", 10);
+            length = 10 + formatInteger(val.ival, line + 10);
+            break;
+        case DOUBLE_TYPE:
+            memcpy(line, "Double : ", 9);
+            length = 9 + formatDouble(val.value, line + 9);
+            break;
+        default:
+            memcpy(line, "No Type : ", 10);
+            length = 10 + formatDouble(val.value, line + 10);
+            break;
     }
-    return result;
-}
 
-RET_VAL evalRand()
-{
-    RET_VAL result;
-    result.value = (double)rand() / (double)RAND_MAX;
-    result.type = DOUBLE_TYPE;
-    return result;
+    line[length++] = '\n';
+    return length;
 }
 
-// TODO
-RET_VAL evalRead()
+// JSON has no nan or inf, so those are written as the strings "nan", "inf" and "-inf"
+static size_t jsonResult(RET_VAL val, char *line)
 {
-    RET_VAL result;
-    printf("read :: ");
-    if(read_target == 0)
-    {
-        double value;
-        scanf("%lf", &value);
-        result.type = DOUBLE_TYPE;
-        result.value = value;
-    }
-    else
-    {
-        double value;
-        fscanf(read_target,"%lf", &value);
-        result.type = DOUBLE_TYPE;
-        result.value = value;
-    }
+    static char *typeNames[] = {"int", "double", "none"};
+    bool quoted = val.type != INT_TYPE && !isfinite(val.value);
+    size_t typeLength = strlen(typeNames[val.type]);
+    size_t length = 0;
 
-    return result;
-}
+    memcpy(line, "{\"type\":\"", 9);
+    length += 9;
+    memcpy(line + length, typeNames[val.type], typeLength);
+    length += typeLength;
+    memcpy(line + length, "\",\"value\":", 10);
+    length += 10;
 
-RET_VAL evalEqual(AST_NODE *node)
-{
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
+    if (quoted)
     {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
+        line[length++] = '"';
     }
-    else if(!node->next)
+    if (val.type == INT_TYPE)
     {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
+        length += formatInteger(val.ival, line + length);
     }
-
-    num1 = eval(node);
-    num2 = eval(node->next);
-    if(num1.value == num2.value)
-        num1.value = 1;
     else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
-}
-
-RET_VAL evalLess(AST_NODE *node)
-{
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
     {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
+        length += formatDouble(val.value, line + length);
     }
-    else if(!node->next)
+    if (quoted)
     {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
+        line[length++] = '"';
     }
 
-    num1 = eval(node);
-    num2 = eval(node->next);
-
-    if(num1.value < num2.value)
-        num1.value = 1;
-    else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
+    memcpy(line + length, "}\n", 2);
+    return length + 2;
 }
 
-RET_VAL evalGreater(AST_NODE *node)
+// little-endian whatever the host, as reader.c loads binary numbers
+static size_t binaryResult(RET_VAL val, char *record)
 {
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
-    }
-
-    num1 = eval(node);
-    num2 = eval(node->next);
+    uint64_t bits;
 
-    if(num1.value > num2.value)
-        num1.value = 1;
-    else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
-}
-
-RET_VAL evalPrint(AST_NODE *node)
-{
-    RET_VAL result;
-
-    if(!node)
-    {
-        warning("print called with no operands!");
-        return NAN_RET_VAL;
-    }
-    if(node->next != NULL)
-        warning("print called with extra (ignored) operands!");
-    result = eval(node);
-    printRetVal(result);
-    return result;
-}
-// TODO 
-RET_VAL evalCustomFunction(AST_NODE *node)
-{
-//    RET_VAL result;
-//    STACK_NODE *stack;
-//    AST_NODE *functionNode;
-//
-//    if(!node)
-//    {
-//        warning("No operands detected!");
-//        return NAN_RET_VAL;
-//    }
-//
-//    functionNode = node->parent;
-//
-//    while(node != NULL)
-//    {
-//        result = eval(node);
-//        stack->value = result;
-//        stack = stack->next;
-//        node = node->next;
-//    }
-//
-//    while(functionNode->data.scope.child->symbolTable != NULL)
-//    {
-//        functionNode->data.scope.child->symbolTable->stack = stack;
-//        functionNode->data.scope.child->symbolTable = functionNode->data.scope.child->symbolTable->next;
-//        stack = stack->next;
-//    }
-//
-//    stack->next = NULL;
-//
-//
-//    return result;
-
-}
-
-RET_VAL evalFuncNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        yyerror("NULL ast node passed into evalFuncNode!");
-        return NAN_RET_VAL; // unreachable but kills a clang-tidy warning
-    }
-
-    // TODO complete the function finished
-    // HINT:
-    // the helper functions that it calls will need to be defined above it
-    // because they are not declared in the .h file (and should not be)
-    RET_VAL result;
-    switch(node->data.function.func)
-    {
-        case NEG_FUNC:
-            result = evalNeg(node->data.function.opList);
-            break;
-        case ADD_FUNC:
-            result = evalAdd(node->data.function.opList);
-            break;
-        case ABS_FUNC:
-            result = evalAbs(node->data.function.opList);
-            break;
-        case SUB_FUNC:
-            result = evalSub(node->data.function.opList);
-            break;
-        case MULT_FUNC:
-            result = evalMult(node->data.function.opList);
-            break;
-        case DIV_FUNC:
-            result = evalDiv(node->data.function.opList);
-            break;
-        case REM_FUNC:
-            result = evalRemainder(node->data.function.opList);
-            break;
-        case EXP_FUNC:
-            result = evalExp(node->data.function.opList);
-            break;
-        case EXP2_FUNC:
-            result = evalExp2(node->data.function.opList);
-            break;
-        case POW_FUNC:
-            result = evalPow(node->data.function.opList);
-            break;
-        case LOG_FUNC:
-            result = evalLog(node->data.function.opList);
-            break;
-        case SQRT_FUNC:
-            result = evalSqrt(node->data.function.opList);
-            break;
-        case CBRT_FUNC:
-            result = evalCbrt(node->data.function.opList);
-            break;
-        case HYPOT_FUNC:
-            result = evalHypot(node->data.function.opList);
-            break;
-        case MAX_FUNC:
-            result = evalMax(node->data.function.opList);
-            break;
-        case MIN_FUNC:
-            result = evalMin(node->data.function.opList);
-            break;
-        case RAND_FUNC:
-            result = evalRand();
-            break;
-        case READ_FUNC:
-            result = evalRead();
-            break;
-        case EQUAL:
-            result = evalEqual(node->data.function.opList);
-            break;
-        case LESS:
-            result = evalLess(node->data.function.opList);
-            break;
-        case GREATER:
-            result = evalGreater(node->data.function.opList);
-            break;
-        case PRINT:
-            result = evalPrint(node->data.function.opList);
-            break;
-        case CUSTOM_FUNC:
-            result = evalCustomFunction(node->data.function.opList);
-        default:
-            warning("WARNING: Function not recognized!");
-
-
-    }
-
-    return result;
-}
-
-RET_VAL evalNumNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        yyerror("NULL ast node passed into evalNumNode!");
-        return NAN_RET_VAL;
-    }
-
-    // TODO complete the function finished
-
-    return node->data.number;
-}
-
-RET_VAL evalSymbolNode(AST_NODE *symbol)
-{
-    AST_NODE *scope = symbol;
-    if (!symbol)
-    {
-        yyerror("NULL ast node passed into evalSymbolNode!");
-        return NAN_RET_VAL;
-    }
-    RET_VAL result;
-
-    while(scope != NULL)
+    if (val.type == INT_TYPE)
     {
-        SYMBOL_TABLE_NODE *current = scope->symbolTable;
-        while(current)
-        {
-            if(strcmp(current->id, symbol->data.symbol.id) == 0)
-            {
-                result = eval(current->value);
-                if(current->value->type != NUM_NODE_TYPE)
-                {
-                    current->value->type = NUM_NODE_TYPE;
-                    current->value->data.number = result;
-                }
-
-                if(result.type == DOUBLE_TYPE && current->type == INT_TYPE)
-                {
-                    warning("Precision loss on int cast from %lf to %d", result.value, (int)round(result.value));
-                    result.type = INT_TYPE;
-                    result.value = round(result.value);
-                }
-                else if(result.type == INT_TYPE && current->type == DOUBLE_TYPE)
-                {
-                    result.type = DOUBLE_TYPE;
-                }
-                /// free Node
-                return result;
-            }
-            else
-            {
-                current = current->next;
-            }
-        }
-        scope = scope->parent;
+        bits = (uint64_t) val.ival;
     }
-
-    warning("Undefined Symbol \"%s\" evaluated! NAN returned!", symbol->data.symbol.id);
-    return NAN_RET_VAL;
-
-
-}
-
-RET_VAL evalCondNode(AST_NODE *node)
-{
-    RET_VAL result;
-
-    if(!node)
-    {
-        warning("NULL ast node passed into evalCondNode!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->data.conditional.condition || !node->data.conditional.ifFalse || !node->data.conditional.ifTrue)
-    {
-        warning("Not enough expressions in evalCondNode!");
-        return NAN_RET_VAL;
-    }
-    result = eval(node->data.conditional.condition);
-    if(result.value != 0)
-        result.value = node->data.conditional.ifTrue->data.number.value;
     else
-        result.value = node->data.conditional.ifFalse->data.number.value;
-
-    result.type = INT_TYPE;
-    return result;
-
-}
-
-RET_VAL eval(AST_NODE *node)
-{
-    if (!node)
     {
-        yyerror("NULL ast node passed into eval!");
-        return NAN_RET_VAL;
+        memcpy(&bits, &val.value, sizeof(bits));
     }
 
-    // TODO complete the function finished
-    switch (node->type) {
-        case NUM_NODE_TYPE:
-            return evalNumNode(node);
-        case FUNC_NODE_TYPE:
-            return evalFuncNode(node);
-        case SCOPE_NODE_TYPE:
-            return eval(node->data.scope.child);
-        case SYM_NODE_TYPE:
-            return evalSymbolNode(node);
-        case COND_NODE_TYPE:
-            return evalCondNode(node);
-        default:
-            yyerror("TYPE not recognized!");
-            return NAN_RET_VAL;
-
+    record[0] = (char) val.type;
+    for (int i = 1; i < RESULT_RECORD_SIZE; i++, bits >>= 8)
+    {
+        record[i] = (char) (bits & 0xFF);
     }
-
-
+    return RESULT_RECORD_SIZE;
 }
 
-// prints the type and value of a RET_VAL
+// prints the type and value of a RET_VAL in the output format, as one write
 void printRetVal(RET_VAL val)
 {
-    switch (val.type)
+    char line[32 + NUMBER_TEXT_SIZE];
+    size_t length;
+
+    switch (output_format)
     {
-        case INT_TYPE:
-            printf("Integer : %.lf\n", val.value);
+        case JSON_OUTPUT:
+            length = jsonResult(val, line);
             break;
-        case DOUBLE_TYPE:
-            printf("Double : %lf\n", val.value);
+        case BINARY_OUTPUT:
+            length = binaryResult(val, line);
             break;
         default:
-            printf("No Type : %lf\n", val.value);
+            length = textResult(val, line);
             break;
     }
-}
-// TODO NEEDS DEBUGGING
-void freeFunctionNode(AST_NODE *function)
-{
-    freeNode(function->data.function.opList);
-}
-
-void freeSymbolTableNode(AST_NODE *symbol)
-{
-    freeNode(symbol->symbolTable->value);
-}
-
-// TODO - DEBUGGING
-void freeNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        return;
-    }
-
-    if(node->type == FUNC_NODE_TYPE){
-        freeFunctionNode(node);
-    }
-//    if(node->type == SYM_NODE_TYPE){
-//        freeSymbolTableNode(node);
-//    }
-    freeNode(node->next);
-    free(node);
-
-
 
+    fwrite(line, 1, length, resultStream());
 }
-
-
@@ -7,21 +7,47 @@
 #include <string.h>
 #include <math.h>
 #include <stdbool.h>
-#include "parser.h"
-
-#define NAN_RET_VAL (RET_VAL){DOUBLE_TYPE, NAN}
-#define ZERO_RET_VAL (RET_VAL){INT_TYPE, 0}
-
-
-#define BISON_FLEX_LOG_PATH "../src/bison-flex-output/bison_flex_log"
-FILE* read_target;
-FILE* flex_bison_log_file;
-
-
-int yyparse(void);
-int yylex(void);
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include "y.tab.h"
+
+#define NAN_RET_VAL (RET_VAL){.type = DOUBLE_TYPE, .value = NAN}
+#define ZERO_RET_VAL (RET_VAL){.type = INT_TYPE, .ival = 0}
+#define INT_RET_VAL(i) ((RET_VAL){.type = INT_TYPE, .ival = (i)})
+#define DOUBLE_RET_VAL(d) ((RET_VAL){.type = DOUBLE_TYPE, .value = (d)})
+
+
+// set by -b: no prompts or echo, and stdout is flushed only when its buffer fills or at exit
+extern bool batch_mode;
+
+// set by -p: how many threads may evaluate the operands of one add, mult,
+// hypot, max or min at once; below 2 nothing is compiled to be forked
+extern int fork_jobs;
+
+// Set by -o: how printRetVal writes results. Outside TEXT_OUTPUT warnings
+// and errors go to stderr, uncolored, so stdout holds nothing but results.
+typedef enum output_format {
+    TEXT_OUTPUT,        // Integer : 5
+    JSON_OUTPUT,        // {"type":"int","value":5}, one object per line
+    BINARY_OUTPUT       // RESULT_RECORD_SIZE bytes: the NUM_TYPE as one byte, then the int64_t or double, little-endian
+} OUTPUT_FORMAT;
+#define RESULT_RECORD_SIZE 9
+extern OUTPUT_FORMAT output_format;
+
+// Results and text warnings go to resultStream(): stdout, unless this thread
+// has set thread_output to collect its part of a parallel batch (batch.c).
+extern _Thread_local FILE *thread_output;
+FILE *resultStream();
+
+
+int yyparse(PARSER *parser);
 void yyerror(char *, ...);
 void warning(char*, ...);
+void parseWarning(PARSER *parser, char *format, ...);
+void parseError(PARSER *parser, const char *message);
 
 
 typedef enum func_type {
@@ -52,6 +78,7 @@ typedef enum func_type {
 } FUNC_TYPE;
 
 
+extern char *funcNames[];
 FUNC_TYPE resolveFunc(char *);
 
 
@@ -69,18 +96,45 @@ typedef enum {
 
 NUM_TYPE resolveType(char *);
 
+// INT_TYPE numbers are held exactly in ival; everything else uses value.
 typedef struct {
     NUM_TYPE type;
-    double value;
+    union {
+        double value;
+        int64_t ival;
+    };
 } AST_NUMBER;
 
 typedef AST_NUMBER RET_VAL;
 
+double toDouble(RET_VAL number);
+bool isZero(RET_VAL number);
+
+
+// One unique copy of an identifier, made by intern() and kept as long as
+// its table. Two identifiers in the same table are the same name exactly
+// when their atoms are the same.
+typedef struct atom {
+    int id;
+    unsigned int hash;
+    char name[];
+} ATOM;
+
+typedef struct atom_table {
+    ATOM **slots;
+    int capacity;       // always a power of two
+    int count;
+} ATOM_TABLE;
+
+ATOM *intern(ATOM_TABLE *atoms, char *name, size_t length);
+void freeAtoms(ATOM_TABLE *atoms);
 
 typedef struct ast_function {
-    char* id;
+    ATOM *id;
     FUNC_TYPE func;
     struct ast_node *opList;
+    struct symbol_table_node *binding;  // CUSTOM_FUNC's lambda, set by resolve()
+    int depth;                          // frames between the call and the lambda's let
 } AST_FUNCTION;
 
 
@@ -93,7 +147,9 @@ typedef enum ast_node_type {
 } AST_NODE_TYPE;
 
 typedef struct {
-    char* id;
+    ATOM *id;
+    struct symbol_table_node *binding;  // set by resolve(), NULL if undefined
+    int depth;                          // frames between the reference and binding's frame
 } AST_SYMBOL;
 
 typedef struct {
@@ -110,6 +166,7 @@ typedef struct ast_node {
     AST_NODE_TYPE type;
     struct ast_node *parent;
     struct symbol_table_node *symbolTable;
+    NUM_TYPE resultType;                // set by infer(), NO_TYPE if only known at run time
     union {
         AST_NUMBER number;
         AST_FUNCTION function;
@@ -121,37 +178,365 @@ typedef struct ast_node {
 } AST_NODE;
 
 
+typedef enum {
+    NOT_INFERRED,
+    INFERRING,
+    INFERRED
+} INFER_STATE;
+
 typedef struct symbol_table_node {
-    char *id;
+    ATOM *id;
     NUM_TYPE type;
     AST_NODE *value;
     SYMBOL_TYPE symbolType;
-    struct stack_node *stack;
+    int index;                          // slot in the enclosing frame, set by resolve()
+    NUM_TYPE valueType;                 // static type of the value after any cast, set by infer()
+    INFER_STATE inferState;
     struct symbol_table_node *next;
 } SYMBOL_TABLE_NODE;
 
-typedef struct stack_node {
-    RET_VAL value;
-    struct stack_node *next;
-} STACK_NODE;
-
-
-AST_NODE *createNumberNode(double value, NUM_TYPE type);
-AST_NODE *createFunctionNode(FUNC_TYPE func, AST_NODE *opList);
-AST_NODE *createCustomFunctionNode(char *id, AST_NODE *opList);
-AST_NODE *createSymbolNode(char *id);
-AST_NODE *createScopeNode(SYMBOL_TABLE_NODE *tableNode, AST_NODE *node);
-AST_NODE *createCondNode(AST_NODE *condition, AST_NODE *trueValue, AST_NODE *falseValue);
-SYMBOL_TABLE_NODE *let_list(SYMBOL_TABLE_NODE *let_elem, SYMBOL_TABLE_NODE *let_list);
-SYMBOL_TABLE_NODE *createVariableTableNode(NUM_TYPE type, char *id, AST_NODE *s_expr);
-SYMBOL_TABLE_NODE *createFunctionTableNode(NUM_TYPE type, char *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr);
-SYMBOL_TABLE_NODE *createArgTable(char *id, SYMBOL_TABLE_NODE *arg_list);
-SYMBOL_TABLE_NODE *let_elem(char *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr, NUM_TYPE type);
+
+// Lists the parser builds left to right, appending at the tail in O(1).
+typedef struct expression_list {
+    AST_NODE *head;
+    AST_NODE *tail;
+} EXPRESSION_LIST;
+
+// Let bindings or lambda arguments. A let list also keeps a hash set of
+// the names it binds, so a duplicate is found without rescanning the list.
+typedef struct binding_list {
+    SYMBOL_TABLE_NODE *head;
+    SYMBOL_TABLE_NODE *tail;
+    SYMBOL_TABLE_NODE **names;          // open addressing on the name's hash
+    int nameCount;
+    int nameCapacity;
+} BINDING_LIST;
+
+// The parser's constructors: everything is allocated in parser->arena.
+AST_NODE *createNumberNode(PARSER *parser, AST_NUMBER number);
+AST_NODE *createFunctionNode(PARSER *parser, FUNC_TYPE func, AST_NODE *opList);
+AST_NODE *createCustomFunctionNode(PARSER *parser, ATOM *id, AST_NODE *opList);
+AST_NODE *createSymbolNode(PARSER *parser, ATOM *id);
+AST_NODE *createScopeNode(PARSER *parser, SYMBOL_TABLE_NODE *tableNode, AST_NODE *node);
+AST_NODE *createCondNode(PARSER *parser, AST_NODE *condition, AST_NODE *trueValue, AST_NODE *falseValue);
+BINDING_LIST *createBindingList(PARSER *parser);
+BINDING_LIST *addToLetList(PARSER *parser, BINDING_LIST *let_list, SYMBOL_TABLE_NODE *let_elem);
+BINDING_LIST *addToArgList(PARSER *parser, BINDING_LIST *arg_list, ATOM *id);
+SYMBOL_TABLE_NODE *createVariableTableNode(PARSER *parser, NUM_TYPE type, ATOM *id, AST_NODE *s_expr);
+SYMBOL_TABLE_NODE *createFunctionTableNode(PARSER *parser, NUM_TYPE type, ATOM *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr);
+SYMBOL_TABLE_NODE *createArgTable(PARSER *parser, ATOM *id, SYMBOL_TABLE_NODE *arg_list);
 AST_NODE *addExpressionToList(AST_NODE *newExpr, AST_NODE *exprList);
-RET_VAL eval(AST_NODE *node);
+EXPRESSION_LIST *createExpressionList(PARSER *parser);
+EXPRESSION_LIST *appendExpression(EXPRESSION_LIST *exprList, AST_NODE *newExpr);
+void resolve(AST_NODE *node);
+void infer(AST_NODE *node);
 
 void printRetVal(RET_VAL val);
 
-void freeNode(AST_NODE *node);
+// reader.c: the numbers (read) takes from a read target, each an INT or a
+// DOUBLE as written. Every VM has its own.
+typedef struct reader READER;
+READER *createReader(FILE *source, bool sharesInput);
+void freeReader(READER *reader);
+RET_VAL readNumber(READER *reader);
+bool readTargetEnded(READER *reader);
+void rewindReadTarget(READER *reader);
+char *yymapinput(FILE *stream, size_t *n);
+
+// A read target file may instead hold its numbers in binary: the magic and
+// version, the NUM_TYPE of every value as one byte (NO_TYPE when each value
+// is tagged with its own), two zero bytes, then the values as little-endian
+// int64_t or double. A tagged value is its NUM_TYPE byte followed by the number.
+// Only a read target that can be mapped is read as binary.
+#define BINARY_READ_MAGIC "CLRD"
+#define BINARY_READ_VERSION 1
+#define BINARY_READ_HEADER_SIZE 8
+
+// Text of a number, written by format.c without a terminating NUL. Either
+// function writes at most NUMBER_TEXT_SIZE chars and returns how many it wrote.
+#define NUMBER_TEXT_SIZE 32
+size_t formatInteger(int64_t value, char *buffer);
+size_t formatDouble(double value, char *buffer);
+
+
+// Bytecode compiled from an AST_NODE tree by compile() and executed by run().
+// Each instruction is an opcode and a single integer operand; numbers live in
+// the constant pool and are referenced by index.
+typedef enum opcode {
+    OP_CONST,           // push constants[arg]
+    OP_LOAD_ARG,        // push slot arg of the frame depth levels up
+    OP_LOAD_VAR,        // same, but evaluates the let binding on first use
+    OP_ENTER,           // push a let frame described by lets[arg]
+    OP_LEAVE,           // pop arg let frames, keeping the body's value
+    OP_CAST,            // convert the top value to NUM_TYPE arg
+    OP_RETURN_THUNK,    // store a let binding's value in its slot and resume the load
+    OP_CALL,            // call functions[arg], defined depth levels up, on the values atop the stack
+    OP_TAIL_CALL,       // like OP_CALL, but reuses the running lambda's frame
+    OP_RETURN,          // pop the lambda's frame and resume the caller
+    OP_NEG,
+    OP_ABS,
+    OP_ADD,             // arg operands
+    OP_SUB,
+    OP_MULT,            // arg operands
+    OP_DIV,
+    OP_REM,
+    OP_EXP,
+    OP_EXP2,
+    OP_POW,
+    OP_LOG,
+    OP_SQRT,
+    OP_CBRT,
+    OP_HYPOT,           // arg operands
+    OP_MAX,             // arg operands
+    OP_MIN,             // arg operands
+    OP_RAND,
+    OP_READ,
+    OP_EQUAL,
+    OP_LESS,
+    OP_GREATER,
+    OP_PRINT,
+    // forms of the above for operands infer() has proved to be all ints or all doubles
+    OP_ADD_INT,         // arg operands
+    OP_SUB_INT,
+    OP_MULT_INT,        // arg operands
+    OP_EQUAL_INT,
+    OP_LESS_INT,
+    OP_GREATER_INT,
+    OP_ADD_DOUBLE,      // arg operands
+    OP_SUB_DOUBLE,
+    OP_MULT_DOUBLE,     // arg operands
+    OP_DIV_DOUBLE,
+    OP_EQUAL_DOUBLE,
+    OP_LESS_DOUBLE,
+    OP_GREATER_DOUBLE,
+    OP_JUMP,            // pc = arg
+    OP_JUMP_IF_FALSE,   // pop, pc = arg if the popped value is 0
+    OP_JUMP_IF_ZERO,    // same, for a value known to be an int
+    OP_FORK,            // offer tasks[arg] and the tasks after it, up to the last, to idle threads
+    OP_JOIN,            // take back tasks[arg] to run inline, or push its value and skip its code
+    OP_TASK_END,        // end of tasks[arg]'s code
+    OP_HALT             // return the top of the stack
+} OPCODE;
+
+typedef struct instruction {
+    unsigned char op;
+    unsigned short depth;
+    int arg;
+} INSTRUCTION;
+
+typedef struct let_info {
+    int slotCount;
+    int firstThunk;     // thunks[firstThunk + i] is the code of binding i
+    int need;           // operand stack the body can use
+} LET_INFO;
+
+// A binding whose value is already a number needs no code: its pc is
+// READY_THUNK and its slot starts out forced to value.
+#define READY_THUNK -1
+
+typedef struct thunk_info {
+    int pc;
+    int need;
+    RET_VAL value;
+} THUNK_INFO;
+
+// An operand OP_FORK may hand to another thread. Its code, [pc, end), runs
+// inline when no thread has taken it, and ends in OP_TASK_END.
+typedef struct task_info {
+    int pc;
+    int end;
+    int need;           // operand stack the code can use, starting from empty
+    bool last;          // of the tasks one OP_FORK offers
+} TASK_INFO;
+
+typedef struct function_info {
+    int pc;
+    int need;
+    int argCount;
+} FUNCTION_INFO;
+
+typedef struct bytecode {
+    INSTRUCTION *code;
+    int codeCount;
+    int codeCapacity;
+    RET_VAL *constants;
+    int constCount;
+    int constCapacity;
+    LET_INFO *lets;
+    int letCount;
+    int letCapacity;
+    THUNK_INFO *thunks;
+    int thunkCount;
+    int thunkCapacity;
+    FUNCTION_INFO *functions;
+    int functionCount;
+    int functionCapacity;
+    TASK_INFO *tasks;
+    int taskCount;
+    int taskCapacity;
+    int maxStack;       // deepest operand stack the main code can reach
+} BYTECODE;
+
+// Let bindings and arguments live in frames on the VM's slot stack, apart
+// from the operand stack. A let slot holds the index of its binding's thunk
+// until the first load evaluates it.
+#define FORCED -1
+#define FORCING -2
+
+typedef struct slot {
+    RET_VAL value;
+    int thunk;
+} SLOT;
+
+typedef struct env_frame {
+    int base;           // slots index of slot 0
+    int size;           // slots in the frame
+    int link;           // frame of the lexically enclosing scope, -1 at top level
+} ENV_FRAME;
+
+typedef struct call_record {
+    INSTRUCTION *returnPc;
+    int env;
+    int slot;           // slots index of the binding being evaluated, -1 for calls
+} CALL_RECORD;
+
+// Everything an evaluation changes lives in its VM: the stacks, the read
+// target's position and the random number state. run() only reads the
+// BYTECODE, so one compiled program can run on many VMs at once, one per
+// thread, each with its own inputs.
+typedef struct vm {
+    RET_VAL *stack;
+    int stackCapacity;
+    int sp;
+    SLOT *slots;
+    int slotCapacity;
+    int slotCount;
+    ENV_FRAME *frames;
+    int frameCount;
+    int frameCapacity;
+    CALL_RECORD *calls;
+    int callCount;
+    int callCapacity;
+    struct fork_group **forks;  // one for each OP_FORK whose tasks are not all joined; NULL if none was offered
+    int forkCount;
+    int forkCapacity;
+    READER *reader;
+    struct random_data random;
+    char randomState[128];      // as big as rand()'s, so the same seed gives the same numbers
+} VM;
+
+#define VARIADIC -1
+
+// Per-builtin facts shared by the passes over the AST, indexed by FUNC_TYPE.
+typedef struct func_info {
+    OPCODE op;
+    int minOperands;
+    int maxOperands;    // VARIADIC for no upper bound
+    bool pure;          // no side effects and the same result for the same operands
+} FUNC_INFO;
+
+extern FUNC_INFO funcInfo[];
+
+void fold(AST_NODE *node, VM *vm);
+BYTECODE *compile(AST_NODE *node);
+void freeBytecode(BYTECODE *bytecode);
+VM *createVM(FILE *readTarget, bool sharesInput);
+void freeVM(VM *vm);
+RET_VAL run(VM *vm, BYTECODE *bytecode);
+RET_VAL eval(AST_NODE *node, VM *vm);
+
+// fork.c: the threads that run the operands offered by OP_FORK. A task is run
+// by the thread that takes it, on its own VM, in a copy of the frames the
+// operand could reach when it was offered; whatever it writes is kept for
+// the thread that joins it to write where the operand would have.
+typedef struct fork_task {
+    struct fork_group *group;
+    int index;          // in the BYTECODE's tasks
+    bool done;          // set by a thread that took the task, once result and output are final
+    RET_VAL result;
+    char *output;
+    size_t outputSize;
+} FORK_TASK;
+
+typedef struct fork_group {
+    BYTECODE *bytecode;
+    int firstTask;
+    int taskCount;
+    ENV_FRAME *frames;  // the lexical chain at the OP_FORK, innermost first, with bases into slots
+    int frameCount;
+    SLOT *slots;
+    int slotCount;
+    FORK_TASK tasks[];
+} FORK_GROUP;
+
+void startForkPool(int jobs);
+void stopForkPool();
+bool wantsFork();
+void forkTasks(FORK_GROUP *group);
+bool joinTask(VM *vm, FORK_TASK *task);
+void runTask(VM *vm, FORK_TASK *task);
+
+
+// Bump-pointer allocator for everything the parser builds for one top-level
+// expression. Blocks are kept across resets, so after the first few lines
+// parsing allocates nothing and releasing a whole tree is O(1).
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+} ARENA_BLOCK;
+
+typedef struct arena {
+    ARENA_BLOCK *first;
+    ARENA_BLOCK *current;
+} ARENA;
+
+void *arenaAlloc(ARENA *arena, size_t size);
+void arenaReset(ARENA *arena);
+void arenaFree(ARENA *arena);
+
+
+// Everything one parse reads, builds and reports through. Each parser has
+// its own scanner, atoms, arena and VM, so independent inputs can be parsed
+// and evaluated at once, one parser per thread. Only the options set by main
+// and the warnings of the passes after parsing are shared.
+struct parser {
+    void *scanner;              // the reentrant flex scanner, whose extra is this parser
+    ATOM_TABLE atoms;
+    ARENA arena;                // the tree of the expression being parsed
+    VM *vm;                     // each expression is evaluated on it as soon as it is parsed
+    FILE *input;
+    FILE *readTarget;
+    FILE *diagnostics;          // parse warnings and errors; NULL for where warning() writes
+    int errorCount;
+    bool ended;                 // quit or the EOF character was parsed, so nothing after it is
+    bool echoInput;             // lines read from input are echoed outside batch mode
+    bool blockInput;            // input is read in large blocks rather than a character at a time
+    bool parseOnly;             // each expression is built and dropped, not evaluated; for bench.c
+    char *mappedInput;          // input mapped whole for a batch run, or NULL
+    size_t mappedSize;
+    void *textBuffer;           // the scanner's copy of the text given to scanText, or NULL
+    char *block;                // input read ahead, of which [blockStart, blockEnd) is unused
+    size_t blockStart;
+    size_t blockEnd;
+    char *line;                 // the line being fed to the scanner
+    size_t lineSize;
+    size_t lineLength;
+    size_t lineOffset;
+    bool inputEnded;
+    struct trace_ring *trace;   // NULL unless tokens are traced
+};
+
+PARSER *createParser(FILE *input, FILE *readTarget);
+void freeParser(PARSER *parser);
+void scanText(PARSER *parser, char *text, size_t length);
+void yystarttrace(PARSER *parser, FILE *log);
+
+// batch.c: evaluates text, a whole batch input, on jobs threads and writes
+// the results in input order. Returns main's exit status.
+int evalBatch(char *text, size_t length, FILE *readTarget, int jobs);
 
 #endif
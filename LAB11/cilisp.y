@@ -1,62 +1,78 @@
+%code requires {
+    typedef struct parser PARSER;
+}
+
 %{
     #include "cilisp.h"
     #define ylog(r, p) {printf("BISON: %s ::= %s \n", #r, #p);}
-    int yylex();
-    void yyerror(char*, ...);
 %}
 
+// The parser is pure: all of its state is on its stack or in the PARSER
+// passed to yyparse, so any number of parses can run at once.
+%define api.pure full
+%param {PARSER *parser}
+
+%code {
+    // flex's reentrant scanner is called with its own state, which the parser holds
+    int yylex(YYSTYPE *lvalp, void *scanner);
+    #define yylex(lvalp, parser) yylex(lvalp, (parser)->scanner)
+
+    // syntax errors end this parse only; yyerror itself exits
+    #define yyerror(parser, message) parseError(parser, message)
+}
+
 %union {
-    char *ident;
+    struct atom *ident;
     double dval;
+    int64_t lval;
     int ival;
     struct ast_node *astNode;
     struct symbol_table_node *symNode;
+    struct expression_list *exprList;
+    struct binding_list *bindingList;
 };
 
 %token <ival> FUNC TYPE
-%token <dval> INT
+%token <lval> INT
 %token <dval> DOUBLE
 %token <ident> SYMBOL
-%token QUIT EOL EOFT COND
+%token QUIT EOFT COND
 %token LPAREN RPAREN LET LAMBDA
 
-%type <astNode> s_expr f_expr number s_expr_list
+%type <astNode> s_expr f_expr number
 %type <astNode> s_expr_section
-%type <symNode> let_elem let_list let_section arg_list
+%type <symNode> let_elem let_section
+%type <exprList> s_expr_list
+%type <bindingList> let_list arg_list
 
 %%
 
+// The input is one stream of top-level expressions, which may span lines or
+// share one. Each is evaluated as soon as its last token arrives: the parser
+// reduces it without reading a lookahead token first.
 program:
-    s_expr EOL {
-        //ylog(program, s_expr EOL);
-        if ($1) {
-            printRetVal(eval($1));
-            freeNode($1);
-        }
-        YYACCEPT;
+    /*empty*/ {
+        //ylog(program, empty);
     }
-    | s_expr EOFT {
-        //ylog(program, s_expr EOFT);
-        if ($1) {
-            printRetVal(eval($1));
-            freeNode($1);
+    | program s_expr {
+        //ylog(program, program s_expr);
+        if (!parser->parseOnly) {
+            printRetVal(eval($2, parser->vm));
         }
-        exit(EXIT_SUCCESS);
-    }
-    | EOL {
-        //ylog(program, EOL);
-        YYACCEPT;  // paranoic; main skips blank lines
+        arenaReset(&parser->arena);
     }
-    | EOFT {
-        //ylog(program, EOFT);
-        exit(EXIT_SUCCESS);
+    | program EOFT {
+        //ylog(program, program EOFT);
+        parser->ended = true;
+        YYACCEPT;
     };
 
 
 s_expr:
     QUIT {
         //ylog(s_expr, QUIT);
-        exit(EXIT_SUCCESS);
+        parser->ended = true;
+        YYACCEPT;
     }
     | f_expr {
         //ylog(s_expr, f_expr);
@@ -68,68 +84,69 @@ s_expr:
     }
     | SYMBOL {
         //ylog(s_expr, SYMBOL);
-        $$ = createSymbolNode($1);
+        $$ = createSymbolNode(parser, $1);
     }
     | LPAREN let_section s_expr RPAREN {
         //ylog(s_expr, let_section);
-        $$ = createScopeNode($2, $3);
+        $$ = createScopeNode(parser, $2, $3);
     }
     | LPAREN COND s_expr s_expr s_expr RPAREN {
         //ylog(s_expr, COND);
-        $$ = createConditionNode($3, $4, $5);
+        $$ = createCondNode(parser, $3, $4, $5);
     }
     | error {
         //ylog(s_expr, error);
-        yyerror("unexpected token");
-        $$ = NULL;
+        YYABORT;
     };
 
 let_section:
     LPAREN LET let_list RPAREN {
         //ylog(let_section, let_list);
-        $$ = $3;
+        $$ = $3->head;
     };
 
+// Lists are left-recursive so the parser stack stays shallow however long
+// they get; each element is appended at the tail as soon as it is reduced.
 let_list:
     let_elem {
         //ylog(let_list, let_elem);
-        $$ = $1;
+        $$ = addToLetList(parser, createBindingList(parser), $1);
     }
-    | let_elem let_list {
+    | let_list let_elem {
         //ylog(let_list, let_list);
-        $$ = createLetList($1, $2);
+        $$ = addToLetList(parser, $1, $2);
     };
 
 let_elem:
     LPAREN SYMBOL s_expr RPAREN {
         //ylog(let_elem, SYMBOL);
         //ylog(let_elem, s_expr);
-        $$ = createLetElem(VAR_TYPE, NO_TYPE, $2, $3, NULL);
+        $$ = createVariableTableNode(parser, NO_TYPE, $2, $3);
     }
     | LPAREN TYPE SYMBOL s_expr RPAREN {
-        $$ = createLetElem(VAR_TYPE, $2, $3, $4, NULL);
+        $$ = createVariableTableNode(parser, $2, $3, $4);
     }
     | LPAREN SYMBOL LAMBDA LPAREN arg_list RPAREN s_expr RPAREN {
-        $$ = createLetElem(LAMBDA_TYPE, NO_TYPE, $2, $7, $5);
+        $$ = createFunctionTableNode(parser, NO_TYPE, $2, $5->head, $7);
     }
     | LPAREN TYPE SYMBOL LAMBDA LPAREN arg_list RPAREN s_expr RPAREN {
-        $$ = createLetElem(LAMBDA_TYPE, $2, $3, $8, $6);
+        $$ = createFunctionTableNode(parser, $2, $3, $6->head, $8);
     };
 
 f_expr:
       LPAREN FUNC s_expr_section RPAREN {
         //ylog(f_expr, s_expr_section);
-        $$ = createFunctionNode(NULL, $2, $3);
+        $$ = createFunctionNode(parser, $2, $3);
     }
     | LPAREN SYMBOL s_expr_section RPAREN {
         //ylog(f_expr, s_expr_section);
-        $$ = createFunctionNode($2, CUSTOM_FUNC, $3);
+        $$ = createCustomFunctionNode(parser, $2, $3);
     };
 
 s_expr_section:
     s_expr_list {
         //ylog(s_expr_section, s_expr_list);
-        $$ = $1;
+        $$ = $1->head;
     }
     | /*empty*/ {
         //ylog(s_expr_section, empty);
@@ -139,34 +156,34 @@ s_expr_section:
 s_expr_list:
     s_expr {
         //ylog(s_expr_list, s_expr);
-        $$ = $1;
+        $$ = appendExpression(createExpressionList(parser), $1);
     }
-    | s_expr s_expr_list {
-        //ylog(s_expr, s_expr_list);
-        $$ = addExpressionToList($1, $2); 
+    | s_expr_list s_expr {
+        //ylog(s_expr_list, s_expr);
+        $$ = appendExpression($1, $2);
     };
 
 arg_list:
-    SYMBOL {
-        //ylog(arg_list, SYMBOL);
-        $$ = createArg($1);
+    /*empty*/ {
+        $$ = createBindingList(parser);
     }
-    | SYMBOL arg_list {
-        //ylog(arg_list, arg_list);
-        $$ = createArgList($1, $2);
-    }
-    | /*empty*/ {
-        $$ = NULL;
-    };    
+    | arg_list SYMBOL {
+        //ylog(arg_list, SYMBOL);
+        $$ = addToArgList(parser, $1, $2);
+    };
 
 number:
       INT {
         //ylog(number, INT);
-        $$ = createNumberNode($1, INT_TYPE);
+        $$ = createNumberNode(parser, INT_RET_VAL($1));
     }
     | DOUBLE {
         //ylog(number, DOUBLE);
-        $$ = createNumberNode($1, DOUBLE_TYPE);
+        $$ = createNumberNode(parser, DOUBLE_RET_VAL($1));
     };
 %%
 
+// the run and bench scripts put more code after the parser, where yylex
+// and yyerror are the functions again
+#undef yylex
+#undef yyerror
@@ -0,0 +1,698 @@
+#include "cilisp.h"
+
+// compile:
+// Translates an AST_NODE tree into a flat BYTECODE program for run().
+// Operand counts are checked once here, so the warnings about missing or
+// extra operands are issued at compile time and the VM never re-checks them.
+// Let bindings and lambda bodies are compiled out of line, after the main
+// code. A binding runs the first time its slot is loaded in each activation
+// of its let, and its value is kept in that activation's frame, never in the
+// AST; a binding that is just a number is stored when the let is entered.
+// A lambda body is compiled once, at its first call site, and shared by
+// every call.
+// Calls in tail position of a lambda body reuse the caller's frame.
+// Where infer() has proved the operand types, the type-specialized opcodes
+// are used and casts that cannot change anything are left out.
+// With -p, the costly pure operands of add, mult, hypot, max and min are
+// compiled as tasks another thread may run (see markForkedOperands).
+
+// Indexed by FUNC_TYPE; must be in sync with the enum just like funcNames.
+FUNC_INFO funcInfo[] = {
+        {OP_NEG, 1, 1, true},
+        {OP_ABS, 1, 1, true},
+        {OP_ADD, 1, VARIADIC, true},
+        {OP_SUB, 2, 2, true},
+        {OP_MULT, 1, VARIADIC, true},
+        {OP_DIV, 2, 2, true},
+        {OP_REM, 2, 2, true},
+        {OP_EXP, 1, 1, true},
+        {OP_EXP2, 1, 1, true},
+        {OP_POW, 2, 2, true},
+        {OP_LOG, 1, 1, true},
+        {OP_SQRT, 1, 1, true},
+        {OP_CBRT, 1, 1, true},
+        {OP_HYPOT, 1, VARIADIC, true},
+        {OP_MAX, 1, VARIADIC, true},
+        {OP_MIN, 1, VARIADIC, true},
+        {OP_RAND, 0, 0, false},
+        {OP_READ, 0, 0, false},
+        {OP_EQUAL, 2, 2, true},
+        {OP_LESS, 2, 2, true},
+        {OP_GREATER, 2, 2, true},
+        {OP_PRINT, 1, 1, false}
+};
+
+typedef struct pending_code {
+    SYMBOL_TABLE_NODE *binding;
+    int thunk;          // index in thunks, or -1 for a lambda body
+    int function;       // index in functions, or -1 for a let binding
+    struct pending_code *next;
+} PENDING_CODE;
+
+typedef struct compiler {
+    BYTECODE *bytecode;
+    int regionMax;      // deepest stack use of the code region being compiled
+    PENDING_CODE *pending;
+    SYMBOL_TABLE_NODE **lambdas;    // lambdas[i] is compiled into functions[i]
+    int lambdaCapacity;
+    SYMBOL_TABLE_NODE *lambda;      // lambda whose body is being compiled, NULL elsewhere
+    int letDepth;                   // let frames entered since the start of that body
+} COMPILER;
+
+static void compileNode(COMPILER *compiler, AST_NODE *node, int depth, bool tail);
+
+// An operand is worth forking when a static count of the instructions it
+// runs reaches FORK_MIN_COST. A call to a lambda whose body is still being
+// counted is recursive, and counts as MAX_COST.
+#define FORK_MIN_COST 256
+#define MAX_COST (1 << 24)
+
+typedef struct lambda_cost {
+    SYMBOL_TABLE_NODE *lambda;
+    int cost;           // MAX_COST while its body is being counted
+} LAMBDA_COST;
+
+typedef struct cost_estimate {
+    LAMBDA_COST *lambdas;
+    int lambdaCount;
+    int lambdaCapacity;
+    bool forkable;      // pure, and reading no binding from outside that is not already a number
+} COST_ESTIMATE;
+
+// doubles the capacity of a growable array when count has reached it
+static void *grow(void *array, int *capacity, int count, size_t elementSize, int initial)
+{
+    if (count < *capacity)
+    {
+        return array;
+    }
+
+    *capacity = *capacity ? 2 * *capacity : initial;
+    if ((array = realloc(array, *capacity * elementSize)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    return array;
+}
+
+static int emit(COMPILER *compiler, OPCODE op, int arg)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+    bytecode->code = grow(bytecode->code, &bytecode->codeCapacity, bytecode->codeCount, sizeof(INSTRUCTION), 32);
+
+    bytecode->code[bytecode->codeCount].op = op;
+    bytecode->code[bytecode->codeCount].depth = 0;
+    bytecode->code[bytecode->codeCount].arg = arg;
+    return bytecode->codeCount++;
+}
+
+static int addConstant(COMPILER *compiler, RET_VAL value)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+    bytecode->constants = grow(bytecode->constants, &bytecode->constCapacity, bytecode->constCount, sizeof(RET_VAL), 8);
+
+    bytecode->constants[bytecode->constCount] = value;
+    return bytecode->constCount++;
+}
+
+// called for every instruction that pushes, so regionMax bounds what run() needs
+static void pushed(COMPILER *compiler, int depth)
+{
+    if (depth + 1 > compiler->regionMax)
+    {
+        compiler->regionMax = depth + 1;
+    }
+}
+
+static void emitConstant(COMPILER *compiler, RET_VAL value, int depth)
+{
+    emit(compiler, OP_CONST, addConstant(compiler, value));
+    pushed(compiler, depth);
+}
+
+static void addPending(COMPILER *compiler, SYMBOL_TABLE_NODE *binding, int thunk, int function)
+{
+    PENDING_CODE *pending;
+
+    if ((pending = calloc(sizeof(PENDING_CODE), 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    pending->binding = binding;
+    pending->thunk = thunk;
+    pending->function = function;
+    pending->next = compiler->pending;
+    compiler->pending = pending;
+}
+
+// a binding that is just a number, stored when its let is entered; a cast could warn
+static bool isReadyBinding(SYMBOL_TABLE_NODE *binding)
+{
+    AST_NODE *value = binding->value;
+    return value && value->type == NUM_NODE_TYPE && (binding->type == NO_TYPE || value->resultType == binding->type);
+}
+
+static int countArgs(SYMBOL_TABLE_NODE *lambda)
+{
+    int count = 0;
+    for (SYMBOL_TABLE_NODE *arg = lambda->value->symbolTable; arg != NULL; arg = arg->next)
+    {
+        count++;
+    }
+    return count;
+}
+
+// index of lambda's code in functions, queueing its body the first time it is called
+static int functionIndex(COMPILER *compiler, SYMBOL_TABLE_NODE *lambda)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+
+    for (int i = 0; i < bytecode->functionCount; i++)
+    {
+        if (compiler->lambdas[i] == lambda)
+        {
+            return i;
+        }
+    }
+
+    bytecode->functions = grow(bytecode->functions, &bytecode->functionCapacity, bytecode->functionCount, sizeof(FUNCTION_INFO), 4);
+    compiler->lambdas = grow(compiler->lambdas, &compiler->lambdaCapacity, bytecode->functionCount, sizeof(SYMBOL_TABLE_NODE *), 4);
+
+    int function = bytecode->functionCount++;
+    compiler->lambdas[function] = lambda;
+    bytecode->functions[function].argCount = countArgs(lambda);
+    addPending(compiler, lambda, -1, function);
+
+    return function;
+}
+
+// A tail call may replace the running lambda's frame only if the callee is
+// defined outside that lambda's body, and only if no cast of the caller's
+// result is skipped by returning straight from the callee.
+static bool canTailCall(COMPILER *compiler, AST_NODE *node)
+{
+    SYMBOL_TABLE_NODE *lambda = node->data.function.binding;
+
+    return compiler->lambda != NULL
+           && node->data.function.depth > compiler->letDepth
+           && (compiler->lambda->type == NO_TYPE || compiler->lambda->type == lambda->type);
+}
+
+static void compileCall(COMPILER *compiler, AST_NODE *node, int depth, bool tail)
+{
+    SYMBOL_TABLE_NODE *lambda = node->data.function.binding;
+    AST_NODE *operand = node->data.function.opList;
+    int count = 0;
+
+    if (!lambda)
+    {
+        // resolve() has already reported it
+        emitConstant(compiler, NAN_RET_VAL, depth);
+        return;
+    }
+
+    int argCount = countArgs(lambda);
+    for (AST_NODE *op = operand; op != NULL; op = op->next)
+    {
+        count++;
+    }
+
+    if (count < argCount)
+    {
+        warning("%s called with too few arguments! NAN returned!", node->data.function.id->name);
+        emitConstant(compiler, NAN_RET_VAL, depth);
+        return;
+    }
+    if (count > argCount)
+    {
+        warning("%s called with extra (ignored) arguments!", node->data.function.id->name);
+    }
+
+    for (int i = 0; i < argCount; i++)
+    {
+        compileNode(compiler, operand, depth + i, false);
+        operand = operand->next;
+    }
+
+    int function = functionIndex(compiler, lambda);
+    int call;
+    if (tail && canTailCall(compiler, node))
+    {
+        // drop the body's let frames first; the callee's depth is then counted from the lambda's frame
+        if (compiler->letDepth > 0)
+        {
+            emit(compiler, OP_LEAVE, compiler->letDepth);
+        }
+        call = emit(compiler, OP_TAIL_CALL, function);
+        compiler->bytecode->code[call].depth = node->data.function.depth - compiler->letDepth;
+    }
+    else
+    {
+        call = emit(compiler, OP_CALL, function);
+        compiler->bytecode->code[call].depth = node->data.function.depth;
+    }
+    pushed(compiler, depth);
+}
+
+// the opcode for func, specialized when its first count operands are all ints or all doubles
+static OPCODE specializedOp(FUNC_TYPE func, AST_NODE *operand, int count)
+{
+    bool allInt = true;
+    bool allDouble = true;
+
+    for (int i = 0; i < count; i++, operand = operand->next)
+    {
+        allInt = allInt && operand->resultType == INT_TYPE;
+        allDouble = allDouble && operand->resultType == DOUBLE_TYPE;
+    }
+
+    switch (func)
+    {
+        case ADD_FUNC:
+            return allInt ? OP_ADD_INT : allDouble ? OP_ADD_DOUBLE : OP_ADD;
+        case SUB_FUNC:
+            return allInt ? OP_SUB_INT : allDouble ? OP_SUB_DOUBLE : OP_SUB;
+        case MULT_FUNC:
+            return allInt ? OP_MULT_INT : allDouble ? OP_MULT_DOUBLE : OP_MULT;
+        case DIV_FUNC:
+            return allDouble ? OP_DIV_DOUBLE : OP_DIV;
+        case EQUAL_FUNC:
+            return allInt ? OP_EQUAL_INT : allDouble ? OP_EQUAL_DOUBLE : OP_EQUAL;
+        case LESS_FUNC:
+            return allInt ? OP_LESS_INT : allDouble ? OP_LESS_DOUBLE : OP_LESS;
+        case GREATER_FUNC:
+            return allInt ? OP_GREATER_INT : allDouble ? OP_GREATER_DOUBLE : OP_GREATER;
+        default:
+            return funcInfo[func].op;
+    }
+}
+
+static int addCosts(int a, int b)
+{
+    return a + b < MAX_COST ? a + b : MAX_COST;
+}
+
+static int estimateCost(COST_ESTIMATE *estimate, AST_NODE *node, int letFrames);
+
+// the cost of a lambda's body, counted once per estimate
+static int estimateCallCost(COST_ESTIMATE *estimate, SYMBOL_TABLE_NODE *lambda)
+{
+    for (int i = 0; i < estimate->lambdaCount; i++)
+    {
+        if (estimate->lambdas[i].lambda == lambda)
+        {
+            return estimate->lambdas[i].cost;
+        }
+    }
+
+    estimate->lambdas = grow(estimate->lambdas, &estimate->lambdaCapacity, estimate->lambdaCount, sizeof(LAMBDA_COST), 4);
+    int visit = estimate->lambdaCount++;
+    estimate->lambdas[visit].lambda = lambda;
+    estimate->lambdas[visit].cost = MAX_COST;
+
+    // the body runs in the lambda's own frame, so no let of the operand is in reach
+    int cost = estimateCost(estimate, lambda->value, 0);
+    estimate->lambdas[visit].cost = cost;
+    return cost;
+}
+
+// letFrames is the number of let frames entered since the operand or the lambda body
+static int estimateCost(COST_ESTIMATE *estimate, AST_NODE *node, int letFrames)
+{
+    int cost = 1;
+
+    switch (node->type)
+    {
+        case NUM_NODE_TYPE:
+            break;
+        case SYM_NODE_TYPE:
+            if (node->data.symbol.binding != NULL && node->data.symbol.binding->symbolType != ARG_TYPE
+                && node->data.symbol.depth >= letFrames && !isReadyBinding(node->data.symbol.binding))
+            {
+                estimate->forkable = false;
+            }
+            break;
+        case FUNC_NODE_TYPE:
+            if (node->data.function.func == CUSTOM_FUNC)
+            {
+                if (node->data.function.binding != NULL)
+                {
+                    cost = addCosts(cost, estimateCallCost(estimate, node->data.function.binding));
+                }
+            }
+            else if (!funcInfo[node->data.function.func].pure)
+            {
+                estimate->forkable = false;
+            }
+            for (AST_NODE *op = node->data.function.opList; op != NULL; op = op->next)
+            {
+                cost = addCosts(cost, estimateCost(estimate, op, letFrames));
+            }
+            break;
+        case SCOPE_NODE_TYPE:
+            for (SYMBOL_TABLE_NODE *current = node->data.scope.child->symbolTable; current != NULL; current = current->next)
+            {
+                if (current->symbolType == VAR_TYPE)
+                {
+                    cost = addCosts(cost, estimateCost(estimate, current->value, letFrames + 1));
+                }
+            }
+            cost = addCosts(cost, estimateCost(estimate, node->data.scope.child, letFrames + 1));
+            break;
+        case COND_NODE_TYPE:
+        {
+            int ifTrue = estimateCost(estimate, node->data.conditional.ifTrue, letFrames);
+            int ifFalse = estimateCost(estimate, node->data.conditional.ifFalse, letFrames);
+            cost = addCosts(cost, estimateCost(estimate, node->data.conditional.condition, letFrames));
+            cost = addCosts(cost, ifTrue > ifFalse ? ifTrue : ifFalse);
+            break;
+        }
+        default:
+            yyerror("TYPE not recognized!");
+    }
+    return cost;
+}
+
+// Marks the operands to fork and returns how many there are. The first
+// costly operand is left to this thread, which runs it while others take
+// the rest, and only pure operands are forked, so rand, read and print are
+// still evaluated in order by this thread.
+static int markForkedOperands(AST_NODE *operand, int count, bool *forked)
+{
+    bool costlySeen = false;
+    int marked = 0;
+
+    for (int i = 0; i < count; i++, operand = operand->next)
+    {
+        COST_ESTIMATE estimate = {NULL, 0, 0, true};
+        int cost = estimateCost(&estimate, operand, 0);
+        free(estimate.lambdas);
+
+        if (cost >= FORK_MIN_COST)
+        {
+            forked[i] = costlySeen && estimate.forkable;
+            marked += forked[i];
+            costlySeen = true;
+        }
+    }
+    return marked;
+}
+
+// Compiles count operands, forking the ones worth it: OP_FORK offers them to
+// idle threads, and each is joined where its value is due, in operand order,
+// so the reduction after them combines the values as if none had been forked.
+static void compileForkedOperands(COMPILER *compiler, AST_NODE *operand, int count, int depth)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+    bool *forked;
+
+    if ((forked = calloc(count, sizeof(bool))) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    // one fork's tasks are contiguous, so they are all taken before any operand is compiled
+    int taskCount = markForkedOperands(operand, count, forked);
+    int task = bytecode->taskCount;
+    while (bytecode->taskCount < task + taskCount)
+    {
+        bytecode->tasks = grow(bytecode->tasks, &bytecode->taskCapacity, bytecode->taskCount, sizeof(TASK_INFO), 4);
+        bytecode->taskCount++;
+    }
+    if (taskCount > 0)
+    {
+        emit(compiler, OP_FORK, task);
+    }
+
+    for (int i = 0; i < count; i++, operand = operand->next)
+    {
+        if (!forked[i])
+        {
+            compileNode(compiler, operand, depth + i, false);
+            continue;
+        }
+
+        emit(compiler, OP_JOIN, task);
+        bytecode->tasks[task].pc = bytecode->codeCount;
+
+        // a stolen task starts on an empty operand stack
+        int outerMax = compiler->regionMax;
+        compiler->regionMax = 0;
+        compileNode(compiler, operand, 0, false);
+        int need = compiler->regionMax;
+        compiler->regionMax = outerMax > depth + i + need ? outerMax : depth + i + need;
+
+        emit(compiler, OP_TASK_END, task);
+        bytecode->tasks[task].end = bytecode->codeCount;
+        bytecode->tasks[task].need = need;
+        bytecode->tasks[task].last = --taskCount == 0;
+        task++;
+    }
+
+    free(forked);
+}
+
+static void compileFuncNode(COMPILER *compiler, AST_NODE *node, int depth, bool tail)
+{
+    FUNC_TYPE func = node->data.function.func;
+    AST_NODE *operand = node->data.function.opList;
+    int count = 0;
+
+    if (func == CUSTOM_FUNC)
+    {
+        compileCall(compiler, node, depth, tail);
+        return;
+    }
+
+    FUNC_INFO info = funcInfo[func];
+    for (AST_NODE *op = operand; op != NULL; op = op->next)
+    {
+        count++;
+    }
+
+    if (count < info.minOperands)
+    {
+        // add and mult keep their identity element as the empty result
+        if (func == ADD_FUNC && count == 0)
+        {
+            warning("add called with no operands! 0 returned!");
+            emitConstant(compiler, ZERO_RET_VAL, depth);
+        }
+        else if (func == MULT_FUNC && count == 0)
+        {
+            warning("mult called with no operands! 1 returned!");
+            emitConstant(compiler, INT_RET_VAL(1), depth);
+        }
+        else
+        {
+            warning("%s called with too few operands! NAN returned!", funcNames[func]);
+            emitConstant(compiler, NAN_RET_VAL, depth);
+        }
+        return;
+    }
+
+    if (info.maxOperands != VARIADIC && count > info.maxOperands)
+    {
+        warning("%s called with extra (ignored) operands!", funcNames[func]);
+        count = info.maxOperands;
+    }
+
+    AST_NODE *first = operand;
+    if (fork_jobs > 1 && info.maxOperands == VARIADIC && count > 1)
+    {
+        compileForkedOperands(compiler, operand, count, depth);
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            compileNode(compiler, operand, depth + i, false);
+            operand = operand->next;
+        }
+    }
+
+    // rand and read push a value without consuming any operands
+    pushed(compiler, depth);
+    emit(compiler, specializedOp(func, first, count), count);
+}
+
+static void compileCondNode(COMPILER *compiler, AST_NODE *node, int depth, bool tail)
+{
+    AST_CONDITIONAL *cond = &node->data.conditional;
+
+    compileNode(compiler, cond->condition, depth, false);
+    int jumpToFalse = emit(compiler, cond->condition->resultType == INT_TYPE ? OP_JUMP_IF_ZERO : OP_JUMP_IF_FALSE, 0);
+    compileNode(compiler, cond->ifTrue, depth, tail);
+    int jumpToEnd = emit(compiler, OP_JUMP, 0);
+    compiler->bytecode->code[jumpToFalse].arg = compiler->bytecode->codeCount;
+    compileNode(compiler, cond->ifFalse, depth, tail);
+    compiler->bytecode->code[jumpToEnd].arg = compiler->bytecode->codeCount;
+}
+
+static void compileSymbolNode(COMPILER *compiler, AST_NODE *node, int depth)
+{
+    SYMBOL_TABLE_NODE *binding = node->data.symbol.binding;
+
+    if (!binding)
+    {
+        // resolve() has already reported it
+        emitConstant(compiler, NAN_RET_VAL, depth);
+        return;
+    }
+    if (node->data.symbol.depth > USHRT_MAX)
+    {
+        yyerror("Scopes nested too deeply to address \"%s\"!", node->data.symbol.id->name);
+    }
+
+    int load = emit(compiler, binding->symbolType == ARG_TYPE ? OP_LOAD_ARG : OP_LOAD_VAR, binding->index);
+    compiler->bytecode->code[load].depth = node->data.symbol.depth;
+    pushed(compiler, depth);
+}
+
+static void compileScopeNode(COMPILER *compiler, AST_NODE *node, int depth, bool tail)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+    AST_NODE *body = node->data.scope.child;
+    int slotCount = 0;
+
+    bytecode->lets = grow(bytecode->lets, &bytecode->letCapacity, bytecode->letCount, sizeof(LET_INFO), 4);
+    int let = bytecode->letCount++;
+    bytecode->lets[let].firstThunk = bytecode->thunkCount;
+
+    // queue every variable's code to be compiled after the current region
+    for (SYMBOL_TABLE_NODE *current = body->symbolTable; current != NULL; current = current->next)
+    {
+        if (current->symbolType != VAR_TYPE)
+        {
+            continue;
+        }
+
+        bytecode->thunks = grow(bytecode->thunks, &bytecode->thunkCapacity, bytecode->thunkCount, sizeof(THUNK_INFO), 8);
+        int thunk = bytecode->thunkCount++;
+        slotCount++;
+
+        if (isReadyBinding(current))
+        {
+            bytecode->thunks[thunk].pc = READY_THUNK;
+            bytecode->thunks[thunk].value = current->value->data.number;
+            continue;
+        }
+        addPending(compiler, current, thunk, -1);
+    }
+    bytecode->lets[let].slotCount = slotCount;
+
+    emit(compiler, OP_ENTER, let);
+
+    // OP_ENTER reserves the body's operand stack along with the frame
+    int outerMax = compiler->regionMax;
+    compiler->regionMax = 0;
+    compiler->letDepth++;
+    compileNode(compiler, body, 0, tail);
+    compiler->letDepth--;
+    bytecode->lets[let].need = compiler->regionMax;
+    compiler->regionMax = outerMax;
+
+    emit(compiler, OP_LEAVE, 1);
+    pushed(compiler, depth);
+}
+
+// emits each queued binding or lambda body as: value, optional cast, return
+static void compilePending(COMPILER *compiler)
+{
+    BYTECODE *bytecode = compiler->bytecode;
+
+    while (compiler->pending != NULL)
+    {
+        PENDING_CODE *pending = compiler->pending;
+        compiler->pending = pending->next;
+
+        int pc = bytecode->codeCount;
+        compiler->regionMax = 0;
+        compiler->lambda = pending->function >= 0 ? pending->binding : NULL;
+        compiler->letDepth = 0;
+        AST_NODE *value = pending->binding->value;
+        compileNode(compiler, value, 0, compiler->lambda != NULL);
+        if (pending->binding->type != NO_TYPE && value->resultType != pending->binding->type)
+        {
+            emit(compiler, OP_CAST, pending->binding->type);
+        }
+
+        if (pending->function >= 0)
+        {
+            emit(compiler, OP_RETURN, 0);
+            bytecode->functions[pending->function].pc = pc;
+            bytecode->functions[pending->function].need = compiler->regionMax;
+        }
+        else
+        {
+            emit(compiler, OP_RETURN_THUNK, 0);
+            bytecode->thunks[pending->thunk].pc = pc;
+            bytecode->thunks[pending->thunk].need = compiler->regionMax;
+        }
+
+        free(pending);
+    }
+}
+
+// depth is the number of values already on the operand stack when node's value is pushed;
+// tail is set when node's value is the value of the lambda body being compiled
+static void compileNode(COMPILER *compiler, AST_NODE *node, int depth, bool tail)
+{
+    switch (node->type)
+    {
+        case NUM_NODE_TYPE:
+            emitConstant(compiler, node->data.number, depth);
+            break;
+        case FUNC_NODE_TYPE:
+            compileFuncNode(compiler, node, depth, tail);
+            break;
+        case SCOPE_NODE_TYPE:
+            compileScopeNode(compiler, node, depth, tail);
+            break;
+        case SYM_NODE_TYPE:
+            compileSymbolNode(compiler, node, depth);
+            break;
+        case COND_NODE_TYPE:
+            compileCondNode(compiler, node, depth, tail);
+            break;
+        default:
+            yyerror("TYPE not recognized!");
+    }
+}
+
+// node must already have been through resolve() and infer()
+BYTECODE *compile(AST_NODE *node)
+{
+    COMPILER compiler = {NULL, 0, NULL, NULL, 0, NULL, 0};
+
+    if ((compiler.bytecode = calloc(sizeof(BYTECODE), 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    compileNode(&compiler, node, 0, false);
+    emit(&compiler, OP_HALT, 0);
+    compiler.bytecode->maxStack = compiler.regionMax;
+
+    compilePending(&compiler);
+    free(compiler.lambdas);
+
+    return compiler.bytecode;
+}
+
+void freeBytecode(BYTECODE *bytecode)
+{
+    if (!bytecode)
+    {
+        return;
+    }
+
+    free(bytecode->code);
+    free(bytecode->constants);
+    free(bytecode->lets);
+    free(bytecode->thunks);
+    free(bytecode->functions);
+    free(bytecode->tasks);
+    free(bytecode);
+}
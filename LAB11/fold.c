@@ -0,0 +1,161 @@
+#include "cilisp.h"
+
+// fold:
+// Replaces every call to a pure builtin whose operands are all numbers with
+// a single number node holding its value, working bottom-up so nested
+// constant subtrees collapse completely. The value is computed by compiling
+// and running the call itself on vm, so folded and unfolded results
+// (including their INT/DOUBLE type) are the same. Calls that would warn when evaluated
+// are left alone so the warning still shows up at the right time.
+
+// Whether running func on these numbers would warn about an integer
+// overflow, checked the way the VM's integer operations check it.
+static bool overflows(FUNC_TYPE func, AST_NODE *operand)
+{
+    AST_NUMBER a = operand->data.number;
+    AST_NUMBER b = operand->next != NULL ? operand->next->data.number : a;
+    bool ints = a.type == INT_TYPE && b.type == INT_TYPE;
+    int64_t result;
+
+    switch (func)
+    {
+        case NEG_FUNC:
+        case ABS_FUNC:
+            return a.type == INT_TYPE && a.ival == INT64_MIN;
+        case EXP2_FUNC:
+            return a.type == INT_TYPE && a.ival >= 63;
+        case SUB_FUNC:
+            return ints && __builtin_sub_overflow(a.ival, b.ival, &result);
+        case DIV_FUNC:
+            return ints && a.ival == INT64_MIN && b.ival == -1;
+        case POW_FUNC:
+        {
+            int64_t power = 1;
+            int64_t square = a.ival;
+
+            if (!ints || b.ival < 0)
+            {
+                return false;
+            }
+            for (int64_t exponent = b.ival; exponent > 0; exponent >>= 1)
+            {
+                if ((exponent & 1) && __builtin_mul_overflow(power, square, &power))
+                {
+                    return true;
+                }
+                if (exponent > 1 && __builtin_mul_overflow(square, square, &square))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case ADD_FUNC:
+        case MULT_FUNC:
+            // the running result stays an int until an operand is a double, after which nothing overflows
+            if (a.type != INT_TYPE)
+            {
+                return false;
+            }
+            result = a.ival;
+            for (operand = operand->next; operand != NULL; operand = operand->next)
+            {
+                if (operand->data.number.type != INT_TYPE)
+                {
+                    return false;
+                }
+                if (func == ADD_FUNC ? __builtin_add_overflow(result, operand->data.number.ival, &result)
+                                     : __builtin_mul_overflow(result, operand->data.number.ival, &result))
+                {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+static bool isFoldable(AST_NODE *node)
+{
+    FUNC_TYPE func = node->data.function.func;
+    int count = 0;
+
+    if (func == CUSTOM_FUNC || !funcInfo[func].pure)
+    {
+        return false;
+    }
+
+    for (AST_NODE *op = node->data.function.opList; op != NULL; op = op->next)
+    {
+        if (op->type != NUM_NODE_TYPE)
+        {
+            return false;
+        }
+        count++;
+    }
+
+    if (count < funcInfo[func].minOperands
+        || (funcInfo[func].maxOperands != VARIADIC && count > funcInfo[func].maxOperands))
+    {
+        return false;
+    }
+
+    // division by zero warns at run time, and so does an integer remainder by zero
+    if ((func == DIV_FUNC || func == REM_FUNC) && isZero(node->data.function.opList->next->data.number))
+    {
+        return false;
+    }
+
+    // so does integer overflow, which must come after the side effects of earlier operands
+    return !overflows(func, node->data.function.opList);
+}
+
+static void foldFuncNode(AST_NODE *node, VM *vm)
+{
+    for (AST_NODE *op = node->data.function.opList; op != NULL; op = op->next)
+    {
+        fold(op, vm);
+    }
+
+    if (!isFoldable(node))
+    {
+        return;
+    }
+
+    infer(node);
+    BYTECODE *bytecode = compile(node);
+    RET_VAL result = run(vm, bytecode);
+    freeBytecode(bytecode);
+
+    // the operands stay in the arena until the whole expression is released
+    node->type = NUM_NODE_TYPE;
+    node->data.number = result;
+}
+
+void fold(AST_NODE *node, VM *vm)
+{
+    switch (node->type)
+    {
+        case NUM_NODE_TYPE:
+        case SYM_NODE_TYPE:
+            break;
+        case FUNC_NODE_TYPE:
+            foldFuncNode(node, vm);
+            break;
+        case SCOPE_NODE_TYPE:
+            for (SYMBOL_TABLE_NODE *current = node->data.scope.child->symbolTable; current != NULL; current = current->next)
+            {
+                fold(current->value, vm);
+            }
+            fold(node->data.scope.child, vm);
+            break;
+        case COND_NODE_TYPE:
+            fold(node->data.conditional.condition, vm);
+            fold(node->data.conditional.ifTrue, vm);
+            fold(node->data.conditional.ifFalse, vm);
+            break;
+        default:
+            yyerror("TYPE not recognized!");
+    }
+}
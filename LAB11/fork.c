@@ -0,0 +1,253 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include "cilisp.h"
+
+// fork:
+// The work-stealing pool behind -p. Every thread that evaluates has a deque
+// of the tasks it has offered: it pushes and pops them at the bottom, and
+// threads with nothing to do steal from the top, where the oldest and so
+// the largest tasks are. A thread only offers tasks while some thread is
+// idle and its own deque is nearly empty; the idle count is read without a
+// lock, so while every thread is busy a fork costs one atomic load, and the
+// pool's lock is only taken when tasks are offered. A thread waiting to join
+// a stolen task runs other stolen tasks on its own VM in the meantime, and
+// sleeps only when there are none. The helper threads run until main stops
+// the pool, and are joined then.
+// Warnings outside TEXT_OUTPUT still go straight to stderr, in no set order.
+
+#define MAX_FORK_WORKERS 256
+#define FORK_QUEUE_LIMIT 2      // a thread with this many tasks waiting offers no more
+
+typedef struct worker {
+    FORK_TASK **tasks;
+    int head;           // the oldest task not yet taken
+    int count;          // one past the newest
+    int capacity;
+    pthread_mutex_t lock;
+} WORKER;
+
+// Steals happen with the pool's lock held, and take a deque's lock inside
+// it; a deque's owner takes only its own deque's lock.
+typedef struct fork_pool {
+    WORKER *workers[MAX_FORK_WORKERS];
+    int workerCount;
+    int nextVictim;
+    pthread_t helpers[MAX_FORK_WORKERS];
+    int helperCount;
+    bool stopping;      // helpers return after the task they are running
+    atomic_int idle;    // threads looking for a task to steal or waiting for one to be done; changed with lock held
+    pthread_mutex_t lock;
+    pthread_cond_t changed;     // a task was offered or is done
+} FORK_POOL;
+
+static FORK_POOL pool = {.lock = PTHREAD_MUTEX_INITIALIZER, .changed = PTHREAD_COND_INITIALIZER};
+static _Thread_local WORKER *thread_worker;
+
+// this thread's deque, made the first time it forks; NULL if the pool is full
+static WORKER *currentWorker()
+{
+    WORKER *worker;
+
+    if (thread_worker != NULL)
+    {
+        return thread_worker;
+    }
+    if ((worker = calloc(sizeof(WORKER), 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    pthread_mutex_init(&worker->lock, NULL);
+
+    pthread_mutex_lock(&pool.lock);
+    if (pool.workerCount < MAX_FORK_WORKERS)
+    {
+        pool.workers[pool.workerCount++] = worker;
+        thread_worker = worker;
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    if (thread_worker == NULL)
+    {
+        pthread_mutex_destroy(&worker->lock);
+        free(worker);
+    }
+    return thread_worker;
+}
+
+// The oldest task of the first deque that has one, taking the deques in
+// turn so no thread's tasks are always stolen last. Called with the pool's lock held.
+static FORK_TASK *stealTask()
+{
+    FORK_TASK *task = NULL;
+
+    for (int i = 0; i < pool.workerCount && task == NULL; i++)
+    {
+        WORKER *victim = pool.workers[(pool.nextVictim + i) % pool.workerCount];
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->head < victim->count)
+        {
+            task = victim->tasks[victim->head++];
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+
+    pool.nextVictim = pool.workerCount > 0 ? (pool.nextVictim + 1) % pool.workerCount : 0;
+    return task;
+}
+
+// Runs stolen tasks on vm until awaited is done, or until the pool stops when
+// it is NULL. Called with the pool's lock held.
+static void stealUntilDone(VM *vm, FORK_TASK *awaited)
+{
+    while (awaited == NULL ? !pool.stopping : !awaited->done)
+    {
+        // counted before looking, so a thread that offers tasks after the look sees it and wakes it
+        atomic_fetch_add(&pool.idle, 1);
+        FORK_TASK *task = stealTask();
+
+        if (task == NULL)
+        {
+            pthread_cond_wait(&pool.changed, &pool.lock);
+            atomic_fetch_sub(&pool.idle, 1);
+            continue;
+        }
+        atomic_fetch_sub(&pool.idle, 1);
+
+        pthread_mutex_unlock(&pool.lock);
+        runTask(vm, task);
+        pthread_mutex_lock(&pool.lock);
+
+        task->done = true;
+        pthread_cond_broadcast(&pool.changed);
+    }
+}
+
+static void *helpForks(void *unused)
+{
+    // the tasks are pure, so this VM never reads its read target
+    VM *vm = createVM(NULL, false);
+
+    pthread_mutex_lock(&pool.lock);
+    stealUntilDone(vm, NULL);
+    pthread_mutex_unlock(&pool.lock);
+
+    freeVM(vm);
+    return unused;
+}
+
+// The thread evaluating is one of the jobs; the others only run stolen tasks.
+// No more threads than the pool has deques for are started.
+void startForkPool(int jobs)
+{
+    for (int i = 1; i < jobs && pool.helperCount < MAX_FORK_WORKERS - 1; i++)
+    {
+        if (pthread_create(&pool.helpers[pool.helperCount], NULL, helpForks, NULL) != 0)
+        {
+            yyerror("Could not start a thread for -p!");
+        }
+        pool.helperCount++;
+    }
+}
+
+// Waits for the helpers to finish their tasks and return, then frees every
+// deque. Nothing may be forked once it is called.
+void stopForkPool()
+{
+    pthread_mutex_lock(&pool.lock);
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.changed);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.helperCount; i++)
+    {
+        pthread_join(pool.helpers[i], NULL);
+    }
+    for (int i = 0; i < pool.workerCount; i++)
+    {
+        pthread_mutex_destroy(&pool.workers[i]->lock);
+        free(pool.workers[i]->tasks);
+        free(pool.workers[i]);
+    }
+    pool.helperCount = 0;
+    pool.workerCount = 0;
+    thread_worker = NULL;
+}
+
+// whether an OP_FORK reached now should offer its tasks
+bool wantsFork()
+{
+    WORKER *worker;
+    bool wanted;
+
+    // a stale count only makes one fork more or less
+    if (atomic_load_explicit(&pool.idle, memory_order_relaxed) == 0 || (worker = currentWorker()) == NULL)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    wanted = worker->count - worker->head < FORK_QUEUE_LIMIT;
+    pthread_mutex_unlock(&worker->lock);
+    return wanted;
+}
+
+// Pushes group's tasks last first, so the first to be joined is the newest
+// and is popped back first, while the last is the first stolen.
+void forkTasks(FORK_GROUP *group)
+{
+    WORKER *worker = thread_worker;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->head == worker->count)
+    {
+        worker->head = 0;
+        worker->count = 0;
+    }
+    while (worker->count + group->taskCount > worker->capacity)
+    {
+        worker->capacity = worker->capacity ? 2 * worker->capacity : 16;
+        if ((worker->tasks = realloc(worker->tasks, worker->capacity * sizeof(FORK_TASK *))) == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+    for (int i = group->taskCount - 1; i >= 0; i--)
+    {
+        worker->tasks[worker->count++] = &group->tasks[i];
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    if (atomic_load(&pool.idle) > 0)
+    {
+        pthread_mutex_lock(&pool.lock);
+        pthread_cond_broadcast(&pool.changed);
+        pthread_mutex_unlock(&pool.lock);
+    }
+}
+
+// True when task was still in this thread's deque and has been popped to run
+// inline; otherwise waits, running stolen tasks on vm, until it is done.
+bool joinTask(VM *vm, FORK_TASK *task)
+{
+    WORKER *worker = thread_worker;
+    bool popped = false;
+
+    // tasks forked since task was are all joined, so it is the newest unless it was stolen
+    pthread_mutex_lock(&worker->lock);
+    if (worker->head < worker->count && worker->tasks[worker->count - 1] == task)
+    {
+        worker->count--;
+        popped = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    if (popped)
+    {
+        return true;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    stealUntilDone(vm, task);
+    pthread_mutex_unlock(&pool.lock);
+    return false;
+}
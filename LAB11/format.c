@@ -0,0 +1,456 @@
+#include "cilisp.h"
+
+// format:
+// Writes numbers as text without going through printf. Integers are written
+// two digits at a time. Doubles get the shortest digits that read back as the
+// same double, found with Grisu3 (Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers") or, in the rare cases it cannot
+// decide, a search through printf. They are laid out like Python's repr:
+// 0.1, 3.0, 1e+300. The text does not depend on the locale.
+
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// writes the decimal digits of value to buffer, returning how many there are
+static size_t formatUnsigned(uint64_t value, char *buffer)
+{
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *start = end;
+
+    while (value >= 100)
+    {
+        start -= 2;
+        memcpy(start, digitPairs + 2 * (value % 100), 2);
+        value /= 100;
+    }
+    if (value >= 10)
+    {
+        start -= 2;
+        memcpy(start, digitPairs + 2 * value, 2);
+    }
+    else
+    {
+        *--start = (char) ('0' + value);
+    }
+
+    memcpy(buffer, start, end - start);
+    return end - start;
+}
+
+size_t formatInteger(int64_t value, char *buffer)
+{
+    if (value < 0)
+    {
+        buffer[0] = '-';
+        return 1 + formatUnsigned(-(uint64_t) value, buffer + 1);
+    }
+    return formatUnsigned((uint64_t) value, buffer);
+}
+
+// f * 2^e, with f a 64 bit significand
+typedef struct diy_fp {
+    uint64_t f;
+    int e;
+} DIY_FP;
+
+// f * 2^e is 10^k, rounded to 64 bits
+typedef struct cached_power {
+    uint64_t f;
+    int e;
+    int k;
+} CACHED_POWER;
+
+// scaling by one of these brings the binary exponent into [ALPHA, -32]
+#define GRISU_ALPHA (-60)
+
+#define CACHED_POWERS_MIN_DEC_EXP (-300)
+#define CACHED_POWERS_DEC_STEP 8
+
+static const CACHED_POWER cachedPowers[] = {
+    {0xAB70FE17C79AC6CAULL, -1060, -300},
+    {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+    {0xBE5691EF416BD60CULL, -1007, -284},
+    {0x8DD01FAD907FFC3CULL, -980, -276},
+    {0xD3515C2831559A83ULL, -954, -268},
+    {0x9D71AC8FADA6C9B5ULL, -927, -260},
+    {0xEA9C227723EE8BCBULL, -901, -252},
+    {0xAECC49914078536DULL, -874, -244},
+    {0x823C12795DB6CE57ULL, -847, -236},
+    {0xC21094364DFB5637ULL, -821, -228},
+    {0x9096EA6F3848984FULL, -794, -220},
+    {0xD77485CB25823AC7ULL, -768, -212},
+    {0xA086CFCD97BF97F4ULL, -741, -204},
+    {0xEF340A98172AACE5ULL, -715, -196},
+    {0xB23867FB2A35B28EULL, -688, -188},
+    {0x84C8D4DFD2C63F3BULL, -661, -180},
+    {0xC5DD44271AD3CDBAULL, -635, -172},
+    {0x936B9FCEBB25C996ULL, -608, -164},
+    {0xDBAC6C247D62A584ULL, -582, -156},
+    {0xA3AB66580D5FDAF6ULL, -555, -148},
+    {0xF3E2F893DEC3F126ULL, -529, -140},
+    {0xB5B5ADA8AAFF80B8ULL, -502, -132},
+    {0x87625F056C7C4A8BULL, -475, -124},
+    {0xC9BCFF6034C13053ULL, -449, -116},
+    {0x964E858C91BA2655ULL, -422, -108},
+    {0xDFF9772470297EBDULL, -396, -100},
+    {0xA6DFBD9FB8E5B88FULL, -369, -92},
+    {0xF8A95FCF88747D94ULL, -343, -84},
+    {0xB94470938FA89BCFULL, -316, -76},
+    {0x8A08F0F8BF0F156BULL, -289, -68},
+    {0xCDB02555653131B6ULL, -263, -60},
+    {0x993FE2C6D07B7FACULL, -236, -52},
+    {0xE45C10C42A2B3B06ULL, -210, -44},
+    {0xAA242499697392D3ULL, -183, -36},
+    {0xFD87B5F28300CA0EULL, -157, -28},
+    {0xBCE5086492111AEBULL, -130, -20},
+    {0x8CBCCC096F5088CCULL, -103, -12},
+    {0xD1B71758E219652CULL, -77, -4},
+    {0x9C40000000000000ULL, -50, 4},
+    {0xE8D4A51000000000ULL, -24, 12},
+    {0xAD78EBC5AC620000ULL, 3, 20},
+    {0x813F3978F8940984ULL, 30, 28},
+    {0xC097CE7BC90715B3ULL, 56, 36},
+    {0x8F7E32CE7BEA5C70ULL, 83, 44},
+    {0xD5D238A4ABE98068ULL, 109, 52},
+    {0x9F4F2726179A2245ULL, 136, 60},
+    {0xED63A231D4C4FB27ULL, 162, 68},
+    {0xB0DE65388CC8ADA8ULL, 189, 76},
+    {0x83C7088E1AAB65DBULL, 216, 84},
+    {0xC45D1DF942711D9AULL, 242, 92},
+    {0x924D692CA61BE758ULL, 269, 100},
+    {0xDA01EE641A708DEAULL, 295, 108},
+    {0xA26DA3999AEF774AULL, 322, 116},
+    {0xF209787BB47D6B85ULL, 348, 124},
+    {0xB454E4A179DD1877ULL, 375, 132},
+    {0x865B86925B9BC5C2ULL, 402, 140},
+    {0xC83553C5C8965D3DULL, 428, 148},
+    {0x952AB45CFA97A0B3ULL, 455, 156},
+    {0xDE469FBD99A05FE3ULL, 481, 164},
+    {0xA59BC234DB398C25ULL, 508, 172},
+    {0xF6C69A72A3989F5CULL, 534, 180},
+    {0xB7DCBF5354E9BECEULL, 561, 188},
+    {0x88FCF317F22241E2ULL, 588, 196},
+    {0xCC20CE9BD35C78A5ULL, 614, 204},
+    {0x98165AF37B2153DFULL, 641, 212},
+    {0xE2A0B5DC971F303AULL, 667, 220},
+    {0xA8D9D1535CE3B396ULL, 694, 228},
+    {0xFB9B7CD9A4A7443CULL, 720, 236},
+    {0xBB764C4CA7A44410ULL, 747, 244},
+    {0x8BAB8EEFB6409C1AULL, 774, 252},
+    {0xD01FEF10A657842CULL, 800, 260},
+    {0x9B10A4E5E9913129ULL, 827, 268},
+    {0xE7109BFBA19C0C9DULL, 853, 276},
+    {0xAC2820D9623BF429ULL, 880, 284},
+    {0x80444B5E7AA7CF85ULL, 907, 292},
+    {0xBF21E44003ACDD2DULL, 933, 300},
+    {0x8E679C2F5E44FF8FULL, 960, 308},
+    {0xD433179D9C8CB841ULL, 986, 316},
+    {0x9E19DB92B4E31BA9ULL, 1013, 324},
+};
+
+// x * y, rounded to 64 bits
+static DIY_FP multiplyDiyFp(DIY_FP x, DIY_FP y)
+{
+    uint64_t xLow = x.f & 0xFFFFFFFFu;
+    uint64_t xHigh = x.f >> 32;
+    uint64_t yLow = y.f & 0xFFFFFFFFu;
+    uint64_t yHigh = y.f >> 32;
+
+    uint64_t lowLow = xLow * yLow;
+    uint64_t lowHigh = xLow * yHigh;
+    uint64_t highLow = xHigh * yLow;
+    uint64_t highHigh = xHigh * yHigh;
+
+    uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+    middle += 1u << 31; // round to nearest
+
+    return (DIY_FP) {highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32), x.e + y.e + 64};
+}
+
+static DIY_FP normalizeDiyFp(DIY_FP x)
+{
+    while ((x.f >> 63) == 0)
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+// Splits the positive, finite value into its significand and the two
+// boundaries halfway to its neighbours; anything strictly between them reads
+// back as value. The boundaries share one exponent.
+static void computeBoundaries(double value, DIY_FP *v, DIY_FP *minus, DIY_FP *plus)
+{
+    const uint64_t hiddenBit = (uint64_t) 1 << 52;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint64_t fraction = bits & (hiddenBit - 1);
+    int biasedExponent = (int) (bits >> 52);
+
+    if (biasedExponent == 0)
+    {
+        *v = (DIY_FP) {fraction, 1 - 1075};
+    }
+    else
+    {
+        *v = (DIY_FP) {fraction + hiddenBit, biasedExponent - 1075};
+    }
+
+    // at a power of two the next double down is half as far away
+    bool lowerIsCloser = fraction == 0 && biasedExponent > 1;
+
+    *plus = normalizeDiyFp((DIY_FP) {2 * v->f + 1, v->e - 1});
+    *minus = lowerIsCloser ? (DIY_FP) {4 * v->f - 1, v->e - 2} : (DIY_FP) {2 * v->f - 1, v->e - 1};
+    minus->f <<= minus->e - plus->e;
+    minus->e = plus->e;
+    *v = normalizeDiyFp(*v);
+}
+
+static CACHED_POWER cachedPowerFor(int e)
+{
+    // the smallest k with 10^k * 2^e at least 2^ALPHA; 78913 / 2^18 ~ log10(2)
+    int f = GRISU_ALPHA - e - 1;
+    int k = (f * 78913) / (1 << 18) + (f > 0);
+    int index = (-CACHED_POWERS_MIN_DEC_EXP + k + (CACHED_POWERS_DEC_STEP - 1)) / CACHED_POWERS_DEC_STEP;
+
+    return cachedPowers[index];
+}
+
+// the number of decimal digits in n, and the power of ten of the first
+static int largestPowerOfTen(uint32_t n, uint32_t *power)
+{
+    static const uint32_t powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    int digits = 10;
+
+    while (digits > 1 && n < powers[digits - 1])
+    {
+        digits--;
+    }
+    *power = powers[digits - 1];
+    return digits;
+}
+
+// Moves the last digit down while that brings it closer to the exact value
+// and keeps it inside the boundaries. Fails when the scaled boundaries are too
+// rough to tell whether the digits are the closest, or even inside.
+static bool roundWeed(char *digits, size_t length, uint64_t distanceTooHighW, uint64_t unsafeInterval,
+                      uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+    uint64_t smallDistance = distanceTooHighW - unit;
+    uint64_t bigDistance = distanceTooHighW + unit;
+
+    while (rest < smallDistance && unsafeInterval - rest >= tenKappa
+           && (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+    {
+        digits[length - 1]--;
+        rest += tenKappa;
+    }
+
+    if (rest < bigDistance && unsafeInterval - rest >= tenKappa
+        && (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+    {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+// Generates the shortest digits of a number between low and high, as close
+// to w as they can get; the number is digits * 10^exponent. The scaled values
+// may each be a unit off, so the digits are generated for the slightly wider,
+// unsafe interval and then checked against the narrower, safe one.
+static bool generateDigits(char *digits, size_t *length, int *exponent, DIY_FP low, DIY_FP w, DIY_FP high)
+{
+    uint64_t unit = 1;
+    uint64_t tooHigh = high.f + unit;
+    uint64_t unsafeInterval = tooHigh - (low.f - unit);
+    int shift = -w.e;
+    uint64_t one = (uint64_t) 1 << shift;
+
+    uint32_t integral = (uint32_t) (tooHigh >> shift);
+    uint64_t fractional = tooHigh & (one - 1);
+    uint32_t power;
+
+    *length = 0;
+    for (int kappa = largestPowerOfTen(integral, &power); kappa > 0; power /= 10)
+    {
+        digits[(*length)++] = (char) ('0' + integral / power);
+        integral %= power;
+        kappa--;
+
+        uint64_t rest = ((uint64_t) integral << shift) + fractional;
+        if (rest < unsafeInterval)
+        {
+            *exponent += kappa;
+            return roundWeed(digits, *length, tooHigh - w.f, unsafeInterval, rest, (uint64_t) power << shift, unit);
+        }
+    }
+
+    for (;;)
+    {
+        fractional *= 10;
+        unit *= 10;
+        unsafeInterval *= 10;
+        digits[(*length)++] = (char) ('0' + (fractional >> shift));
+        fractional &= one - 1;
+        (*exponent)--;
+
+        if (fractional < unsafeInterval)
+        {
+            return roundWeed(digits, *length, (tooHigh - w.f) * unit, unsafeInterval, fractional, one, unit);
+        }
+    }
+}
+
+// Grisu3: the shortest digits of the positive, finite value, so that value is
+// digits * 10^exponent. Fails for about one double in two hundred.
+static bool grisu3(double value, char *digits, size_t *length, int *exponent)
+{
+    DIY_FP v, minus, plus;
+    computeBoundaries(value, &v, &minus, &plus);
+
+    CACHED_POWER cached = cachedPowerFor(plus.e);
+    DIY_FP c = {cached.f, cached.e};
+
+    *exponent = -cached.k;
+    return generateDigits(digits, length, exponent, multiplyDiyFp(minus, c), multiplyDiyFp(v, c),
+                          multiplyDiyFp(plus, c));
+}
+
+// Where grisu3 gives up: the fewest correctly rounded digits that read back as
+// value. Reading back is monotonic in the digit count, so it is searched for.
+static size_t shortestByPrintf(double value, char *digits, int *exponent)
+{
+    char text[32];
+    int low = 1;
+    int high = 17;
+
+    while (low < high)
+    {
+        int precision = (low + high) / 2;
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (strtod(text, NULL) == value)
+        {
+            high = precision;
+        }
+        else
+        {
+            low = precision + 1;
+        }
+    }
+
+    // d.ddde+x, though the point may be another character in another locale
+    snprintf(text, sizeof(text), "%.*e", low - 1, value);
+    size_t length = 0;
+    char *c = text;
+    for (; *c != 'e'; c++)
+    {
+        if (*c >= '0' && *c <= '9')
+        {
+            digits[length++] = *c;
+        }
+    }
+    *exponent = atoi(c + 1) - (int) (length - 1);
+    return length;
+}
+
+// Lays out length digits, worth digits * 10^exponent. Fixed notation is used
+// while the decimal exponent is in [-4, 16), always with a digit after the point.
+static size_t layOutDigits(char *digits, size_t length, int exponent, char *buffer)
+{
+    int point = (int) length + exponent; // digits before the decimal point
+    char *out = buffer;
+
+    if (point > -4 && point <= 16)
+    {
+        if (point <= 0)
+        {
+            memcpy(out, "0.", 2);
+            memset(out + 2, '0', -point);
+            out += 2 - point;
+            memcpy(out, digits, length);
+            out += length;
+        }
+        else if ((size_t) point >= length)
+        {
+            memcpy(out, digits, length);
+            memset(out + length, '0', point - length);
+            out += point;
+            memcpy(out, ".0", 2);
+            out += 2;
+        }
+        else
+        {
+            memcpy(out, digits, point);
+            out[point] = '.';
+            memcpy(out + point + 1, digits + point, length - point);
+            out += length + 1;
+        }
+        return out - buffer;
+    }
+
+    *out++ = digits[0];
+    if (length > 1)
+    {
+        *out++ = '.';
+        memcpy(out, digits + 1, length - 1);
+        out += length - 1;
+    }
+
+    int scientific = point - 1;
+    *out++ = 'e';
+    *out++ = scientific < 0 ? '-' : '+';
+    scientific = scientific < 0 ? -scientific : scientific;
+    if (scientific < 10)
+    {
+        *out++ = '0';
+    }
+    out += formatUnsigned((uint64_t) scientific, out);
+    return out - buffer;
+}
+
+size_t formatDouble(double value, char *buffer)
+{
+    char *out = buffer;
+
+    if (isnan(value))
+    {
+        memcpy(buffer, "nan", 3);
+        return 3;
+    }
+    if (signbit(value))
+    {
+        *out++ = '-';
+        value = -value;
+    }
+    if (isinf(value))
+    {
+        memcpy(out, "inf", 3);
+        return out + 3 - buffer;
+    }
+    if (value == 0)
+    {
+        memcpy(out, "0.0", 3);
+        return out + 3 - buffer;
+    }
+
+    char digits[20];
+    size_t length;
+    int exponent;
+    if (!grisu3(value, digits, &length, &exponent))
+    {
+        length = shortestByPrintf(value, digits, &exponent);
+    }
+    return out - buffer + layOutDigits(digits, length, exponent, out);
+}
@@ -0,0 +1,198 @@
+#include "cilisp.h"
+
+// infer:
+// Works out which nodes are certain to produce an int or a double, before
+// anything runs, and records it in each node's resultType. NO_TYPE means the
+// type is only known at run time. The analysis has to be sound rather than
+// precise: integer arithmetic can overflow into a double and arguments take
+// whatever the caller passes, so neither gets a static type. compile() uses
+// the result to pick opcodes that skip the VM's int/double checks.
+
+static NUM_TYPE inferNode(AST_NODE *node);
+
+// the type a binding's slot, or a lambda's call, holds after its cast
+static NUM_TYPE castType(NUM_TYPE declared, NUM_TYPE value)
+{
+    if (declared == DOUBLE_TYPE || declared == NO_TYPE)
+    {
+        return declared == NO_TYPE ? value : DOUBLE_TYPE;
+    }
+
+    // a double that cannot be cast to int is kept as a double
+    return value == INT_TYPE ? INT_TYPE : NO_TYPE;
+}
+
+// a binding that refers to itself while it is being inferred gets NO_TYPE
+static NUM_TYPE inferBinding(SYMBOL_TABLE_NODE *binding)
+{
+    switch (binding->inferState)
+    {
+        case INFERRED:
+            return binding->valueType;
+        case INFERRING:
+            return NO_TYPE;
+        default:
+            binding->inferState = INFERRING;
+            binding->valueType = castType(binding->type, inferNode(binding->value));
+            binding->inferState = INFERRED;
+            return binding->valueType;
+    }
+}
+
+static NUM_TYPE inferCall(AST_NODE *node, int count)
+{
+    SYMBOL_TABLE_NODE *lambda = node->data.function.binding;
+    int argCount = 0;
+
+    if (!lambda)
+    {
+        return DOUBLE_TYPE;
+    }
+
+    for (SYMBOL_TABLE_NODE *arg = lambda->value->symbolTable; arg != NULL; arg = arg->next)
+    {
+        argCount++;
+    }
+
+    // too few arguments is NAN
+    return count < argCount ? DOUBLE_TYPE : inferBinding(lambda);
+}
+
+static NUM_TYPE inferFuncNode(AST_NODE *node)
+{
+    FUNC_TYPE func = node->data.function.func;
+    AST_NODE *operand = node->data.function.opList;
+    bool allInt = true;
+    bool allDouble = true;
+    bool anyDouble = false;
+    int count = 0;
+
+    // every operand is inferred, but only the ones compile() keeps decide the type
+    for (AST_NODE *op = operand; op != NULL; op = op->next)
+    {
+        NUM_TYPE type = inferNode(op);
+        if (func != CUSTOM_FUNC && funcInfo[func].maxOperands != VARIADIC && count >= funcInfo[func].maxOperands)
+        {
+            continue;
+        }
+        allInt = allInt && type == INT_TYPE;
+        allDouble = allDouble && type == DOUBLE_TYPE;
+        anyDouble = anyDouble || type == DOUBLE_TYPE;
+        count++;
+    }
+
+    if (func == CUSTOM_FUNC)
+    {
+        return inferCall(node, count);
+    }
+
+    if (count < funcInfo[func].minOperands)
+    {
+        // the same constants compileFuncNode() substitutes
+        return (func == ADD_FUNC || func == MULT_FUNC) && count == 0 ? INT_TYPE : DOUBLE_TYPE;
+    }
+
+    switch (func)
+    {
+        case NEG_FUNC:
+        case ABS_FUNC:
+        case ADD_FUNC:
+        case SUB_FUNC:
+        case MULT_FUNC:
+        case DIV_FUNC:
+        case REM_FUNC:
+        case EXP2_FUNC:
+        case POW_FUNC:
+            // a double operand makes the result a double; ints may overflow into one
+            return anyDouble ? DOUBLE_TYPE : NO_TYPE;
+        case EXP_FUNC:
+        case LOG_FUNC:
+        case SQRT_FUNC:
+        case CBRT_FUNC:
+        case HYPOT_FUNC:
+        case RAND_FUNC:
+            return DOUBLE_TYPE;
+        case READ_FUNC:
+            // whichever the read target holds
+            return NO_TYPE;
+        case MAX_FUNC:
+        case MIN_FUNC:
+            return allInt ? INT_TYPE : allDouble ? DOUBLE_TYPE : NO_TYPE;
+        case EQUAL_FUNC:
+        case LESS_FUNC:
+        case GREATER_FUNC:
+            return INT_TYPE;
+        case PRINT_FUNC:
+            return operand->resultType;
+        default:
+            return NO_TYPE;
+    }
+}
+
+static NUM_TYPE inferSymbolNode(AST_NODE *node)
+{
+    SYMBOL_TABLE_NODE *binding = node->data.symbol.binding;
+
+    if (!binding)
+    {
+        return DOUBLE_TYPE;
+    }
+    return binding->symbolType == ARG_TYPE ? NO_TYPE : inferBinding(binding);
+}
+
+static NUM_TYPE inferScopeNode(AST_NODE *node)
+{
+    AST_NODE *body = node->data.scope.child;
+
+    // bindings nobody references still get their nodes typed for compile()
+    for (SYMBOL_TABLE_NODE *current = body->symbolTable; current != NULL; current = current->next)
+    {
+        inferBinding(current);
+    }
+
+    return inferNode(body);
+}
+
+static NUM_TYPE inferCondNode(AST_NODE *node)
+{
+    AST_CONDITIONAL *cond = &node->data.conditional;
+
+    inferNode(cond->condition);
+    NUM_TYPE ifTrue = inferNode(cond->ifTrue);
+    NUM_TYPE ifFalse = inferNode(cond->ifFalse);
+
+    return ifTrue == ifFalse ? ifTrue : NO_TYPE;
+}
+
+static NUM_TYPE inferNode(AST_NODE *node)
+{
+    switch (node->type)
+    {
+        case NUM_NODE_TYPE:
+            node->resultType = node->data.number.type;
+            break;
+        case FUNC_NODE_TYPE:
+            node->resultType = inferFuncNode(node);
+            break;
+        case SCOPE_NODE_TYPE:
+            node->resultType = inferScopeNode(node);
+            break;
+        case SYM_NODE_TYPE:
+            node->resultType = inferSymbolNode(node);
+            break;
+        case COND_NODE_TYPE:
+            node->resultType = inferCondNode(node);
+            break;
+        default:
+            yyerror("TYPE not recognized!");
+            node->resultType = NO_TYPE;
+    }
+
+    return node->resultType;
+}
+
+// node must already have been through resolve()
+void infer(AST_NODE *node)
+{
+    inferNode(node);
+}
@@ -0,0 +1,92 @@
+#include "cilisp.h"
+
+// intern:
+// Returns the atom in atoms for the identifier name[0..length), creating it
+// on first sight. Each parser has its own table, an open-addressing hash
+// table kept until the parser is freed, and its atoms get consecutive ids,
+// so the lexer allocates once per distinct name and every later comparison
+// is a pointer compare.
+
+// FNV-1a
+static unsigned int hashName(char *name, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char) name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void growAtoms(ATOM_TABLE *atoms)
+{
+    int oldCapacity = atoms->capacity;
+    ATOM **oldSlots = atoms->slots;
+
+    atoms->capacity = oldCapacity ? 2 * oldCapacity : 256;
+    if ((atoms->slots = calloc(atoms->capacity, sizeof(ATOM *))) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        if (oldSlots[i] != NULL)
+        {
+            unsigned int slot = oldSlots[i]->hash & (atoms->capacity - 1);
+            while (atoms->slots[slot] != NULL)
+            {
+                slot = (slot + 1) & (atoms->capacity - 1);
+            }
+            atoms->slots[slot] = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+}
+
+ATOM *intern(ATOM_TABLE *atoms, char *name, size_t length)
+{
+    // keep the load factor at or below one half
+    if (2 * (atoms->count + 1) > atoms->capacity)
+    {
+        growAtoms(atoms);
+    }
+
+    unsigned int hash = hashName(name, length);
+    unsigned int slot = hash & (atoms->capacity - 1);
+    ATOM *atom;
+
+    while ((atom = atoms->slots[slot]) != NULL)
+    {
+        if (atom->hash == hash && strncmp(atom->name, name, length) == 0 && atom->name[length] == '\0')
+        {
+            return atom;
+        }
+        slot = (slot + 1) & (atoms->capacity - 1);
+    }
+
+    if ((atom = malloc(sizeof(ATOM) + length + 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    atom->id = atoms->count++;
+    atom->hash = hash;
+    memcpy(atom->name, name, length);
+    atom->name[length] = '\0';
+    atoms->slots[slot] = atom;
+
+    return atom;
+}
+
+void freeAtoms(ATOM_TABLE *atoms)
+{
+    for (int i = 0; i < atoms->capacity; i++)
+    {
+        free(atoms->slots[i]);
+    }
+    free(atoms->slots);
+    atoms->slots = NULL;
+    atoms->capacity = 0;
+    atoms->count = 0;
+}
@@ -0,0 +1,471 @@
+#include <unistd.h>
+#include <sys/mman.h>
+#include "cilisp.h"
+
+// reader:
+// The numbers (read) takes from a read target. A regular file is mapped whole
+// and the kernel is told to read ahead of the scan; a pipe is read in large
+// blocks. A terminal, and a read target that is also the program's input,
+// are read a character at a time so nothing past the number is consumed.
+// Numbers are parsed by hand: a token that looks like the lexer's int is an
+// INT unless it overflows, and anything else strtod accepts is a DOUBLE.
+// A mapped file that starts with BINARY_READ_MAGIC holds binary numbers,
+// which are loaded straight out of the map. Binary numbers that cannot be
+// mapped, or whose header is not one this version writes, are refused with a
+// warning, and every read of them is NAN.
+
+#define READER_BLOCK_SIZE (64 * 1024)
+#define MAX_NUMBER_LENGTH 1024          // a longer token is skipped whole and read as NAN
+#define MAX_EXACT_MANTISSA ((uint64_t) 1 << 53)
+
+typedef enum reader_mode {
+    CHAR_READER,
+    MAPPED_READER,
+    BLOCK_READER,
+    BINARY_READER
+} READER_MODE;
+
+struct reader {
+    FILE *source;
+    bool sharesInput;       // source is also where the program is read from
+    bool opened;            // source is only looked at on the first read
+    READER_MODE mode;
+    char *chars;            // the mapped file, a block, or one token
+    size_t start;           // where the numbers begin in the mapped file
+    size_t position;
+    size_t length;
+    bool ended;             // nothing is left in source past chars[length]
+    NUM_TYPE binaryType;    // of every binary value, or NO_TYPE when each is tagged
+    char block[READER_BLOCK_SIZE + 1];
+};
+
+READER *createReader(FILE *source, bool sharesInput)
+{
+    READER *reader;
+
+    if ((reader = calloc(sizeof(READER), 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+        return NULL;
+    }
+    reader->source = source;
+    reader->sharesInput = sharesInput;
+    return reader;
+}
+
+void freeReader(READER *reader)
+{
+    if (reader->mode == MAPPED_READER || reader->mode == BINARY_READER)
+    {
+        munmap(reader->chars, reader->length + 3);
+    }
+    free(reader);
+}
+
+static bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static size_t binaryValueSize(READER *reader)
+{
+    return reader->binaryType == NO_TYPE ? 1 + sizeof(int64_t) : sizeof(int64_t);
+}
+
+static bool isBinary(READER *reader)
+{
+    return reader->length >= 4 && memcmp(reader->chars, BINARY_READ_MAGIC, 4) == 0;
+}
+
+// switches a mapped reader to binary if its file has a binary header
+static void openBinary(READER *reader)
+{
+    unsigned char *header = (unsigned char *) reader->chars;
+
+    if (!isBinary(reader))
+    {
+        return;
+    }
+    if (reader->length < BINARY_READ_HEADER_SIZE || header[4] != BINARY_READ_VERSION || header[5] > NO_TYPE
+        || header[6] != 0 || header[7] != 0)
+    {
+        warning("The read target has an unknown binary header! Its numbers cannot be read.");
+        reader->start = reader->length;
+        reader->position = reader->length;
+        return;
+    }
+
+    reader->mode = BINARY_READER;
+    reader->binaryType = (NUM_TYPE) header[5];
+    reader->start = BINARY_READ_HEADER_SIZE;
+    reader->position = BINARY_READ_HEADER_SIZE;
+}
+
+// keeps more than MAX_NUMBER_LENGTH chars ahead of the position in the block
+static void refillBlock(READER *reader)
+{
+    size_t rest = reader->length - reader->position;
+
+    if (reader->ended || rest > MAX_NUMBER_LENGTH)
+    {
+        return;
+    }
+
+    memmove(reader->block, reader->block + reader->position, rest);
+    reader->position = 0;
+    reader->length = rest + fread(reader->block + rest, 1, READER_BLOCK_SIZE - rest, reader->source);
+    reader->ended = reader->length < READER_BLOCK_SIZE;
+}
+
+static void openReader(READER *reader)
+{
+    size_t size;
+
+    reader->opened = true;
+    reader->mode = CHAR_READER;
+    reader->chars = reader->block;
+    reader->position = 0;
+    reader->length = 0;
+    reader->ended = false;
+
+    if (reader->sharesInput || isatty(fileno(reader->source)))
+    {
+        return;
+    }
+
+    // the map ends in EOF and NULs, which are not part of the numbers
+    if ((reader->chars = yymapinput(reader->source, &size)) != NULL)
+    {
+        reader->mode = MAPPED_READER;
+        reader->start = 0;
+        reader->length = size - 3;
+        reader->ended = true;
+        madvise(reader->chars, reader->length, MADV_SEQUENTIAL | MADV_WILLNEED);
+        openBinary(reader);
+        return;
+    }
+
+    reader->chars = reader->block;
+    reader->mode = BLOCK_READER;
+
+    // binary numbers are only loaded out of a map
+    refillBlock(reader);
+    if (isBinary(reader))
+    {
+        warning("The read target is binary but not a regular file! Its numbers cannot be read.");
+        reader->position = reader->length;
+        reader->ended = true;
+    }
+}
+
+// Reads one token into the block, leaving the char after it in the stream as
+// fscanf would. Past MAX_NUMBER_LENGTH + 1 chars the rest is consumed unstored.
+static void readTokenChars(READER *reader)
+{
+    int c;
+
+    reader->position = 0;
+    reader->length = 0;
+
+    while ((c = fgetc(reader->source)) != EOF && isBlank((char) c));
+    while (c != EOF && !isBlank((char) c))
+    {
+        if (reader->length <= MAX_NUMBER_LENGTH)
+        {
+            reader->block[reader->length++] = (char) c;
+        }
+        c = fgetc(reader->source);
+    }
+    if (c != EOF)
+    {
+        ungetc(c, reader->source);
+    }
+}
+
+// skips whitespace, refilling the block as needed; false when nothing is left
+static bool skipBlanks(READER *reader)
+{
+    for (;;)
+    {
+        if (reader->mode == BLOCK_READER)
+        {
+            refillBlock(reader);
+        }
+        while (reader->position < reader->length && isBlank(reader->chars[reader->position]))
+        {
+            reader->position++;
+        }
+        if (reader->position < reader->length)
+        {
+            break;
+        }
+        if (reader->mode != BLOCK_READER || reader->ended)
+        {
+            return false;
+        }
+    }
+
+    // the whole token must be in the block
+    if (reader->mode == BLOCK_READER)
+    {
+        refillBlock(reader);
+    }
+    return true;
+}
+
+// The next whitespace-separated token, or false when the read target is done.
+// A token longer than MAX_NUMBER_LENGTH is consumed whole, but only its length
+// is meaningful: the block it was in may have been refilled.
+static bool nextToken(READER *reader, char **token, size_t *length)
+{
+    if (reader->mode == CHAR_READER)
+    {
+        readTokenChars(reader);
+    }
+    if (!skipBlanks(reader))
+    {
+        return false;
+    }
+
+    *token = reader->chars + reader->position;
+    size_t end = reader->position;
+    while (end < reader->length && !isBlank(reader->chars[end]))
+    {
+        end++;
+    }
+    *length = end - reader->position;
+    reader->position = end;
+
+    // a block holds more than MAX_NUMBER_LENGTH chars from the token's start, so only a token too long runs past it
+    while (reader->mode == BLOCK_READER && reader->position == reader->length && !reader->ended)
+    {
+        refillBlock(reader);
+        while (reader->position < reader->length && !isBlank(reader->chars[reader->position]))
+        {
+            reader->position++;
+            (*length)++;
+        }
+    }
+    return true;
+}
+
+static bool parseWithStrtod(char *token, size_t length, double *value)
+{
+    char text[MAX_NUMBER_LENGTH + 1];
+    char *end;
+
+    memcpy(text, token, length);
+    text[length] = '\0';
+    *value = strtod(text, &end);
+    return end == text + length;
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits], as long as its value is exact in a double
+static bool parseSimpleDouble(char *token, size_t length, bool negative, size_t i, double *value)
+{
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    int digits = 0;
+
+    for (; i < length && token[i] >= '0' && token[i] <= '9'; i++, digits++)
+    {
+        mantissa = mantissa * 10 + (uint64_t) (token[i] - '0');
+        significant += mantissa != 0;
+    }
+    if (i < length && token[i] == '.')
+    {
+        for (i++; i < length && token[i] >= '0' && token[i] <= '9'; i++, digits++)
+        {
+            mantissa = mantissa * 10 + (uint64_t) (token[i] - '0');
+            significant += mantissa != 0;
+            exponent--;
+        }
+    }
+    if (digits == 0 || significant > 19)
+    {
+        return false;
+    }
+    if (i < length && (token[i] == 'e' || token[i] == 'E'))
+    {
+        bool negativeExponent = false;
+        int explicitExponent = 0;
+        size_t start;
+
+        i++;
+        if (i < length && (token[i] == '+' || token[i] == '-'))
+        {
+            negativeExponent = token[i++] == '-';
+        }
+        for (start = i; i < length && token[i] >= '0' && token[i] <= '9' && explicitExponent < 10000; i++)
+        {
+            explicitExponent = explicitExponent * 10 + (token[i] - '0');
+        }
+        if (i == start)
+        {
+            return false;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (i != length || mantissa > MAX_EXACT_MANTISSA || exponent < -22 || exponent > 22)
+    {
+        return false;
+    }
+
+    // both the mantissa and the power of ten are exact, so one rounding gives the closest double
+    *value = exponent < 0 ? (double) mantissa / powersOfTen[-exponent] : (double) mantissa * powersOfTen[exponent];
+    *value = negative ? -*value : *value;
+    return true;
+}
+
+// An int is [+-]digits, like the lexer's; it is read as a double if it does not fit.
+static bool parseNumber(char *token, size_t length, RET_VAL *number)
+{
+    bool negative = token[0] == '-';
+    size_t i = token[0] == '-' || token[0] == '+';
+    size_t start = i;
+    uint64_t magnitude = 0;
+    uint64_t limit = negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+    double value;
+
+    while (i < length && token[i] >= '0' && token[i] <= '9'
+           && magnitude <= (limit - (uint64_t) (token[i] - '0')) / 10)
+    {
+        magnitude = magnitude * 10 + (uint64_t) (token[i++] - '0');
+    }
+    if (i == length && i > start)
+    {
+        *number = INT_RET_VAL(negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude);
+        return true;
+    }
+
+    if (parseSimpleDouble(token, length, negative, start, &value) || parseWithStrtod(token, length, &value))
+    {
+        *number = DOUBLE_RET_VAL(value);
+        return true;
+    }
+    return false;
+}
+
+// compilers turn this into a single load on little-endian machines
+static uint64_t loadLittleEndian(unsigned char *bytes)
+{
+    uint64_t value = 0;
+
+    for (int i = 7; i >= 0; i--)
+    {
+        value = value << 8 | bytes[i];
+    }
+    return value;
+}
+
+static RET_VAL readBinaryNumber(READER *reader)
+{
+    unsigned char *value = (unsigned char *) reader->chars + reader->position;
+    NUM_TYPE type = reader->binaryType;
+    RET_VAL number;
+
+    if (reader->length - reader->position < binaryValueSize(reader))
+    {
+        warning("read found no more numbers! NAN will be used!");
+        return NAN_RET_VAL;
+    }
+    reader->position += binaryValueSize(reader);
+
+    if (type == NO_TYPE)
+    {
+        type = (NUM_TYPE) *value++;
+    }
+
+    uint64_t bits = loadLittleEndian(value);
+    switch (type)
+    {
+        case INT_TYPE:
+            number = INT_RET_VAL((int64_t) bits);
+            break;
+        case DOUBLE_TYPE:
+            number = DOUBLE_RET_VAL(0);
+            memcpy(&number.value, &bits, sizeof(bits));
+            break;
+        default:
+            warning("read found a binary value tagged %d, which is not a number! NAN will be used!", (int) type);
+            number = NAN_RET_VAL;
+            break;
+    }
+    return number;
+}
+
+RET_VAL readNumber(READER *reader)
+{
+    RET_VAL number;
+    char *token;
+    size_t length;
+
+    if (!reader->opened)
+    {
+        openReader(reader);
+    }
+    if (reader->mode == BINARY_READER)
+    {
+        return readBinaryNumber(reader);
+    }
+
+    if (!nextToken(reader, &token, &length))
+    {
+        warning("read found no more numbers! NAN will be used!");
+        return NAN_RET_VAL;
+    }
+    if (length > MAX_NUMBER_LENGTH)
+    {
+        warning("read found a token longer than %d chars, which is not a number! NAN will be used!", MAX_NUMBER_LENGTH);
+        return NAN_RET_VAL;
+    }
+    if (!parseNumber(token, length, &number))
+    {
+        warning("read found \"%.*s\", which is not a number! NAN will be used!", (int) length, token);
+        return NAN_RET_VAL;
+    }
+    return number;
+}
+
+// whether only whitespace, or no whole binary value, is left in the read target
+bool readTargetEnded(READER *reader)
+{
+    if (!reader->opened)
+    {
+        openReader(reader);
+    }
+    if (reader->mode == BINARY_READER)
+    {
+        return reader->length - reader->position < binaryValueSize(reader);
+    }
+    if (reader->mode == CHAR_READER)
+    {
+        int c;
+        while ((c = fgetc(reader->source)) != EOF && isBlank((char) c));
+        if (c != EOF)
+        {
+            ungetc(c, reader->source);
+        }
+        return c == EOF;
+    }
+    return !skipBlanks(reader);
+}
+
+// starts the read target over from its first number
+void rewindReadTarget(READER *reader)
+{
+    rewind(reader->source);
+    if (reader->mode == MAPPED_READER || reader->mode == BINARY_READER)
+    {
+        reader->position = reader->start;
+    }
+    else
+    {
+        reader->opened = false;
+    }
+}
@@ -0,0 +1,122 @@
+#include "cilisp.h"
+
+// resolve:
+// Binds every SYM_NODE to the let binding or lambda argument it refers to
+// and records how many frames up that binding lives, so the VM can load it
+// straight out of a slot. Calls to custom functions are bound to their
+// lambda the same way. Every let body and every lambda body is a frame.
+// Undefined symbols are reported here, once, instead of on every evaluation.
+
+typedef struct resolve_scope {
+    SYMBOL_TABLE_NODE *table;
+    struct resolve_scope *parent;
+} RESOLVE_SCOPE;
+
+static void resolveNode(AST_NODE *node, RESOLVE_SCOPE *scope);
+
+static void resolveSymbol(AST_NODE *node, RESOLVE_SCOPE *scope)
+{
+    AST_SYMBOL *symbol = &node->data.symbol;
+
+    for (int depth = 0; scope != NULL; depth++, scope = scope->parent)
+    {
+        for (SYMBOL_TABLE_NODE *current = scope->table; current != NULL; current = current->next)
+        {
+            if (current->symbolType != LAMBDA_TYPE && current->id == symbol->id)
+            {
+                symbol->binding = current;
+                symbol->depth = depth;
+                return;
+            }
+        }
+    }
+
+    symbol->binding = NULL;
+    warning("Undefined Symbol \"%s\" referenced! NAN will be used!", symbol->id->name);
+}
+
+static void resolveCall(AST_NODE *node, RESOLVE_SCOPE *scope)
+{
+    AST_FUNCTION *function = &node->data.function;
+
+    for (int depth = 0; scope != NULL; depth++, scope = scope->parent)
+    {
+        for (SYMBOL_TABLE_NODE *current = scope->table; current != NULL; current = current->next)
+        {
+            if (current->symbolType == LAMBDA_TYPE && current->id == function->id)
+            {
+                function->binding = current;
+                function->depth = depth;
+                return;
+            }
+        }
+    }
+
+    function->binding = NULL;
+    warning("Undefined function \"%s\" called! NAN will be used!", function->id->name);
+}
+
+static void resolveLet(AST_NODE *body, RESOLVE_SCOPE *scope)
+{
+    RESOLVE_SCOPE letScope = {body->symbolTable, scope};
+    int index = 0;
+
+    // bindings see each other (and themselves), so they resolve in the let's own scope
+    for (SYMBOL_TABLE_NODE *current = body->symbolTable; current != NULL; current = current->next)
+    {
+        if (current->symbolType == LAMBDA_TYPE)
+        {
+            RESOLVE_SCOPE lambdaScope = {current->value->symbolTable, &letScope};
+            int argIndex = 0;
+            for (SYMBOL_TABLE_NODE *arg = current->value->symbolTable; arg != NULL; arg = arg->next)
+            {
+                arg->index = argIndex++;
+            }
+            resolveNode(current->value, &lambdaScope);
+        }
+        else
+        {
+            current->index = index++;
+            resolveNode(current->value, &letScope);
+        }
+    }
+
+    resolveNode(body, &letScope);
+}
+
+static void resolveNode(AST_NODE *node, RESOLVE_SCOPE *scope)
+{
+    switch (node->type)
+    {
+        case NUM_NODE_TYPE:
+            break;
+        case FUNC_NODE_TYPE:
+            for (AST_NODE *op = node->data.function.opList; op != NULL; op = op->next)
+            {
+                resolveNode(op, scope);
+            }
+            if (node->data.function.func == CUSTOM_FUNC)
+            {
+                resolveCall(node, scope);
+            }
+            break;
+        case SCOPE_NODE_TYPE:
+            resolveLet(node->data.scope.child, scope);
+            break;
+        case SYM_NODE_TYPE:
+            resolveSymbol(node, scope);
+            break;
+        case COND_NODE_TYPE:
+            resolveNode(node->data.conditional.condition, scope);
+            resolveNode(node->data.conditional.ifTrue, scope);
+            resolveNode(node->data.conditional.ifFalse, scope);
+            break;
+        default:
+            yyerror("TYPE not recognized!");
+    }
+}
+
+void resolve(AST_NODE *node)
+{
+    resolveNode(node, NULL);
+}
@@ -1,5007 +0,0 @@
-#include "cilisp.h"
-#include "math.h"
-
-#define RED             "\033[31m"
-#define RESET_COLOR     "\033[0m"
-
-// yyerror:
-// Something went so wrong that the whole program should crash.
-// You should basically never call this unless an allocation fails.
-// (see the "yyerror("Memory allocation failed!")" calls and do the same.
-// This is basically printf, but red, with "\nERROR: " prepended, "\n" appended,
-// and an "exit(1);" at the end to crash the program.
-// It's called "yyerror" instead of "error" so the parser will use it for errors too.
-void yyerror(char *format, ...)
-{
-    char buffer[256];
-    va_list args;
-    va_start (args, format);
-    vsnprintf (buffer, 255, format, args);
-
-    printf(RED "\nERROR: %s\nExiting...\n" RESET_COLOR, buffer);
-    fflush(stdout);
-
-    va_end (args);
-    exit(1);
-}
-
-// warning:
-// Something went mildly wrong (on the user-input level, probably)
-// Let the user know what happened and what you're doing about it.
-// Then, move on. No big deal, they can enter more inputs. ¯\_(ツ)_/¯
-// You should use this pretty often:
-//      too many arguments, let them know and ignore the extra
-//      too few arguments, let them know and return NAN
-//      invalid arguments, let them know and return NAN
-//      many more uses to be added as we progress...
-// This is basically printf, but red, and with "\nWARNING: " prepended and "\n" appended.
-void warning(char *format, ...)
-{
-    char buffer[256];
-    va_list args;
-    va_start (args, format);
-    vsnprintf (buffer, 255, format, args);
-
-    printf(RED "WARNING: %s\n" RESET_COLOR, buffer);
-    fflush(stdout);
-
-    va_end (args);
-}
-
-FUNC_TYPE resolveFunc(char *funcName)
-{
-    // Array of string values for function names.
-    // Must be in sync with members of the FUNC_TYPE enum in order for resolveFunc to work.
-    // For example, funcNames[NEG_FUNC] should be "neg"
-    char *funcNames[] = {
-            "neg",
-            "abs",
-            "add",
-            "sub",
-            "mult",
-            "div",
-            "remainder",
-            "exp",
-            "exp2",
-            "pow",
-            "log",
-            "sqrt",
-            "cbrt",
-            "hypot",
-            "max",
-            "min",
-            "rand",
-            "read",
-            "equal",
-            "less",
-            "greater",
-            "print",
-            "custom",
-
-            // TODO complete the array
-            // the empty string below must remain the last element
-            ""
-    };
-    int i = 0;
-    while (funcNames[i][0] != '\0')
-    {
-        if (strcmp(funcNames[i], funcName) == 0)
-        {
-            return i;
-        }
-        i++;
-    }
-    return CUSTOM_FUNC;
-}
-
-NUM_TYPE resolveType(char * type)
-{
-    if(strcmp(type, "int") == 0 ) return 0;
-    else if(strcmp(type, "double") == 0) return 1;
-}
-
-AST_NODE *createNumberNode(double value, NUM_TYPE type)
-{
-    AST_NODE *node;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    // TODO complete the function finished
-    // Populate "node", the AST_NODE * created above with the argument data.
-    // node is a generic AST_NODE, don't forget to specify it is of type NUMBER_NODE
-    node->data.number.value = value;
-    node->data.number.type = type;
-    node->type = NUM_NODE_TYPE;
-
-    return node;
-}
-
-
-AST_NODE *createFunctionNode(FUNC_TYPE func, AST_NODE *opList)
-{
-    AST_NODE *node;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    // TODO complete the function finished
-    // Populate the allocated AST_NODE *node's data
-    node->type = FUNC_NODE_TYPE;
-    node->data.function.func = func;
-    node->data.function.opList = opList;
-    while(opList != NULL)
-    {
-        opList->parent = node;
-        opList = opList->next;
-    }
-
-    return node;
-}
-
-AST_NODE *createCustomFunctionNode(char *id, AST_NODE *opList)
-{
-    AST_NODE *node;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    // TODO complete the function finished
-    // Populate the allocated AST_NODE *node's data
-    node->type = FUNC_NODE_TYPE;
-    node->data.function.func = CUSTOM_FUNC;
-    node->data.function.opList = opList;
-    while(opList != NULL)
-    {
-        opList->parent = node;
-        opList = opList->next;
-    }
-
-    return node;
-}
-
-AST_NODE *addExpressionToList(AST_NODE *newExpr, AST_NODE *exprList)
-{
-
-    newExpr->next = exprList;
-    return newExpr;
-}
-
-AST_NODE *createSymbolNode(char *id)
-{
-    AST_NODE *node;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE) + sizeof(AST_SYMBOL);
-    if ((node = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    node->type = SYM_NODE_TYPE;
-    node->data.symbol.id = id;
-
-    return node;
-}
-
-AST_NODE *createScopeNode(SYMBOL_TABLE_NODE *let_section, AST_NODE *s_expr)
-{
-    AST_NODE *scopeNode;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE);
-    if ((scopeNode = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    scopeNode->type = SCOPE_NODE_TYPE;
-    s_expr->parent = scopeNode;
-    scopeNode->data.scope.child = s_expr;
-    s_expr->symbolTable = let_section;
-    while (let_section != NULL)
-    {
-        let_section->value->parent = s_expr;
-        let_section = let_section->next;
-    }
-
-
-
-    return scopeNode;
-}
-
-AST_NODE *createCondNode(AST_NODE *condition, AST_NODE *trueValue, AST_NODE *falseValue)
-{
-    AST_NODE *cond;
-    size_t nodeSize;
-
-    nodeSize = sizeof(AST_NODE);
-    if ((cond = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    cond->type = COND_NODE_TYPE;
-    cond->data.conditional.condition = condition;
-    cond->data.conditional.ifTrue = trueValue;
-    cond->data.conditional.ifFalse = falseValue;
-    condition->parent = cond;
-    trueValue->parent = cond;
-    falseValue->parent = cond;
-
-    return cond;
-}
-
-// add symbol to the list
-SYMBOL_TABLE_NODE *let_list(SYMBOL_TABLE_NODE *let_elem, SYMBOL_TABLE_NODE *let_list)
-{
-    SYMBOL_TABLE_NODE *table = let_list;
-
-    int redeclaration = 0;
-    while(table)
-    {
-        if(strcmp(let_elem->id, table->id) == 0)
-        {
-            warning("Duplicate assignment to symbol \"%s\" detected in the same scope!\n"
-                    "Only the first assignment is kept!", table->id);
-            redeclaration = 1;
-            let_list = let_elem;    // let_list takes the value of the head of the let_elem
-            break;
-        }
-        table = table->next;
-    }
-
-    // if it is not a redeclaration, place the symbol at the front of the let_list
-    if(!redeclaration)
-        let_elem->next = let_list;
-
-    return let_elem;
-}
-
-// create symbol table node with data
-SYMBOL_TABLE_NODE *createVariableTableNode(NUM_TYPE type, char *id, AST_NODE *s_expr)
-{
-    SYMBOL_TABLE_NODE *symbolTableNode;
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((symbolTableNode = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    symbolTableNode->id = id;
-    symbolTableNode->value = s_expr;
-    symbolTableNode->type = type;
-    symbolTableNode->symbolType = VAR_TYPE;
-
-    return symbolTableNode;
-}
-
-SYMBOL_TABLE_NODE *createFunctionTableNode( NUM_TYPE type, char *id, SYMBOL_TABLE_NODE *arg_list, AST_NODE *s_expr)
-{
-    SYMBOL_TABLE_NODE *symbolTableNode;
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((symbolTableNode = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    symbolTableNode->id = id;
-    symbolTableNode->value = s_expr;
-    s_expr->symbolTable = arg_list;
-    symbolTableNode->type = type;
-    symbolTableNode->symbolType = LAMBDA_TYPE;
-
-    return symbolTableNode;
-}
-
-SYMBOL_TABLE_NODE *createArgTable(char *id, SYMBOL_TABLE_NODE *arg_list)
-{
-    SYMBOL_TABLE_NODE *table;
-
-    size_t nodeSize;
-
-    nodeSize = sizeof(SYMBOL_TABLE_NODE);
-    if ((table = calloc(nodeSize, 1)) == NULL)
-    {
-        yyerror("Memory allocation failed!");
-        exit(1);
-    }
-
-    table->id = id;
-    table->type = NO_TYPE;
-    table->symbolType = ARG_TYPE;
-    table->next = arg_list;
-
-    return table;
-}
-
-RET_VAL evalNeg(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Neg function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("neg called with extra (ignored) operands!");
-    }
-
-    RET_VAL result;
-    result = eval(node);
-    result.value = -result.value;
-    result.type = result.type;
-    return result;
-
-}
-
-RET_VAL evalAbs(AST_NODE *node)
-{
-
-    if(!node)
-    {
-        warning("No operands in Neg function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Too many operands in Abs function");
-
-    }
-    RET_VAL result;
-    result.value = 0, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = fabs(result.value);
-    result.type = result.type;
-    return result;
-}
-
-RET_VAL evalAdd(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 0, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(node == NULL)
-    {
-        warning("Add called with no operands! 0 returned!");
-        result.type = INT_TYPE;
-        return result;
-    }
-
-
-    while(node != NULL)
-    {
-        result2 = eval(node);
-
-        result.value += result2.value;
-        if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-            result.type = DOUBLE_TYPE;
-        else
-            result.type = INT_TYPE;
-
-        node = node->next;
-    }
-
-    return result;
-}
-
-
-RET_VAL evalSub(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 0, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-    if(!node)
-    {
-        warning("No operands in Sub function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: Sub called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning("Sub called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-    result.value -= result2.value;
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-
-
-
-}
-
-// TODO - DEBUGGING REQUIRED - DOES NOT PRINT RIGHT NUM_TYPE IN SPECIFIC CIRCUMSTANCES
-RET_VAL evalMult(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-
-    if(node == NULL)
-    {
-        warning("Mult called with no operands! 1 returned!");
-        result.type = INT_TYPE;
-        return result;
-    }
-
-    while(node != NULL)
-    {
-        result2 = eval(node);
-
-        result.value *= result2.value;
-        if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-            result.type = DOUBLE_TYPE;
-        else
-            result.type = INT_TYPE;
-        node = node->next;
-
-    }
-
-    return result;
-}
-
-RET_VAL evalDiv(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in div function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: div called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning("Sub called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-
-    if(result2.value == 0)
-    {
-        warning("You cannot divide by zero!");
-        return NAN_RET_VAL;
-    }
-
-    if(result.type == INT_TYPE && result2.type == INT_TYPE)
-    {
-        if(remainder(result.value, result2.value) != 0)
-        {
-            result.value /= result2.value;
-            result.value = floor(result.value);
-        }
-        else result.value /= result2.value;
-    }
-    else
-        result.value /= result2.value;
-
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-}
-
-RET_VAL evalRemainder(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in remainder function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("WARNING: Remainder called with only one arg!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning("Remainder called with extra (ignored) operands!");
-    }
-    result = eval(node);
-    result2 = eval(node->next);
-    result.value = remainder(result.value, result2.value);
-    if (result.value < abs(result2.value) && result.value < 0)
-    {
-        result.value += abs(result2.value);
-    }
-    if(result.type == DOUBLE_TYPE || result2.type == DOUBLE_TYPE)
-        result.type = DOUBLE_TYPE;
-    else
-        result.type = INT_TYPE;
-    return result;
-}
-
-RET_VAL evalExp(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Exp function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Exp called with extra (ignored) operands!");
-
-    }
-
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = exp(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-RET_VAL evalExp2(AST_NODE *node)
-{
-    if(!node)
-    {
-        warning("No operands in Exp2 function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Exp2 called with extra (ignored) operands!");
-
-    }
-
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-    result = eval(node);
-    result.value = exp2(result.value);
-    if (node->data.number.value < 0)
-        result.type = DOUBLE_TYPE;
-//    else
-//        result->type = result->type;
-    return result;
-}
-
-RET_VAL evalPow(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-
-    result.value = 1, result.type = INT_TYPE;
-    result2.value = 1, result2.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in Pow function");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("Pow called with no second operand!");
-        return NAN_RET_VAL;
-    }
-    else if(node->next->next)
-    {
-        warning(" Pow called with extra (ignored) operands!");
-    }
-
-    result = eval(node);
-    result2 = eval(node->next);
-    result.type = result.type || result2.type;
-    result.value = pow(result.value, result2.value);
-
-    return result;
-}
-
-RET_VAL evalLog(AST_NODE *node)
-{
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in Log function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Log called with extra (ignored) operands!");
-
-    }
-    result = eval(node);
-    result.value = log(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-RET_VAL evalSqrt(AST_NODE *node)
-{
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in Sqrt function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Sqrt called with extra (ignored) operands!");
-
-    }
-
-    result = eval(node);
-    result.value = sqrt(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-RET_VAL evalCbrt(AST_NODE *node)
-{
-    RET_VAL result;
-    result.value = 1, result.type = INT_TYPE;
-
-    if(!node)
-    {
-        warning("No operands in Cbrt function");
-        return NAN_RET_VAL;
-    }
-    else if(node->next)
-    {
-        warning("Cbrt called with extra (ignored) operands!");
-
-    }
-
-    result = eval(node);
-    result.value = cbrt(result.value);
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-RET_VAL evalHypot(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = 0;
-
-    if(node == NULL)
-    {
-        warning("WARNING: No operands detected!");
-        return NAN_RET_VAL;
-    }
-
-
-    while(node != NULL)
-    {
-        result2 = eval(node);
-        result2.value = pow(result2.value, 2);
-        result.value += result2.value;
-
-        //printf("add %f", node->data.number.value);
-
-        node = node->next;
-    }
-    result.type = DOUBLE_TYPE;
-    result.value = sqrt(result.value);
-
-    return result;
-}
-
-RET_VAL evalMax(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = -1000;
-
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    while(node != NULL)
-    {
-        result2 = eval(node);
-        if(result.value < result2.value)
-        {
-            result.value = result2.value;
-            result.type = result2.type;
-        }
-
-        node = node->next;
-    }
-    return result;
-}
-
-RET_VAL evalMin(AST_NODE *node)
-{
-    RET_VAL result;
-    RET_VAL result2;
-    result.value = 1000;
-
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    while(node != NULL)
-    {
-        result2 = eval(node);
-        if(result.value > result2.value)
-        {
-            result.value = result2.value;
-            result.type = result2.type;
-        }
-
-        node = node->next;
-    }
-    return result;
-}
-
-RET_VAL evalRand()
-{
-    RET_VAL result;
-    result.value = (double)rand() / (double)RAND_MAX;
-    result.type = DOUBLE_TYPE;
-    return result;
-}
-
-// TODO
-RET_VAL evalRead()
-{
-    RET_VAL result;
-    printf("read :: ");
-    if(read_target == 0)
-    {
-        double value;
-        scanf("%lf", &value);
-        result.type = DOUBLE_TYPE;
-        result.value = value;
-    }
-    else
-    {
-        double value;
-        fscanf(read_target,"%lf", &value);
-        result.type = DOUBLE_TYPE;
-        result.value = value;
-    }
-
-    return result;
-}
-
-RET_VAL evalEqual(AST_NODE *node)
-{
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
-    }
-
-    num1 = eval(node);
-    num2 = eval(node->next);
-    if(num1.value == num2.value)
-        num1.value = 1;
-    else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
-}
-
-RET_VAL evalLess(AST_NODE *node)
-{
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
-    }
-
-    num1 = eval(node);
-    num2 = eval(node->next);
-
-    if(num1.value < num2.value)
-        num1.value = 1;
-    else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
-}
-
-RET_VAL evalGreater(AST_NODE *node)
-{
-    RET_VAL num1;
-    RET_VAL num2;
-    if(!node)
-    {
-        warning("No operands detected!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->next)
-    {
-        warning("Second operand not detected in Equal!");
-        return NAN_RET_VAL;
-    }
-
-    num1 = eval(node);
-    num2 = eval(node->next);
-
-    if(num1.value > num2.value)
-        num1.value = 1;
-    else
-        num1.value = 0;
-
-    num1.type = INT_TYPE;
-
-    return num1;
-}
-
-RET_VAL evalPrint(AST_NODE *node)
-{
-    RET_VAL result;
-
-    if(!node)
-    {
-        warning("print called with no operands!");
-        return NAN_RET_VAL;
-    }
-    if(node->next != NULL)
-        warning("print called with extra (ignored) operands!");
-    result = eval(node);
-    printRetVal(result);
-    return result;
-}
-// TODO 
-RET_VAL evalCustomFunction(AST_NODE *node)
-{
-//    RET_VAL result;
-//    STACK_NODE *stack;
-//    AST_NODE *functionNode;
-//
-//    if(!node)
-//    {
-//        warning("No operands detected!");
-//        return NAN_RET_VAL;
-//    }
-//
-//    functionNode = node->parent;
-//
-//    while(node != NULL)
-//    {
-//        result = eval(node);
-//        stack->value = result;
-//        stack = stack->next;
-//        node = node->next;
-//    }
-//
-//    while(functionNode->data.scope.child->symbolTable != NULL)
-//    {
-//        functionNode->data.scope.child->symbolTable->stack = stack;
-//        functionNode->data.scope.child->symbolTable = functionNode->data.scope.child->symbolTable->next;
-//        stack = stack->next;
-//    }
-//
-//    stack->next = NULL;
-//
-//
-//    return result;
-
-}
-
-RET_VAL evalFuncNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        yyerror("NULL ast node passed into evalFuncNode!");
-        return NAN_RET_VAL; // unreachable but kills a clang-tidy warning
-    }
-
-    // TODO complete the function finished
-    // HINT:
-    // the helper functions that it calls will need to be defined above it
-    // because they are not declared in the .h file (and should not be)
-    RET_VAL result;
-    switch(node->data.function.func)
-    {
-        case NEG_FUNC:
-            result = evalNeg(node->data.function.opList);
-            break;
-        case ADD_FUNC:
-            result = evalAdd(node->data.function.opList);
-            break;
-        case ABS_FUNC:
-            result = evalAbs(node->data.function.opList);
-            break;
-        case SUB_FUNC:
-            result = evalSub(node->data.function.opList);
-            break;
-        case MULT_FUNC:
-            result = evalMult(node->data.function.opList);
-            break;
-        case DIV_FUNC:
-            result = evalDiv(node->data.function.opList);
-            break;
-        case REM_FUNC:
-            result = evalRemainder(node->data.function.opList);
-            break;
-        case EXP_FUNC:
-            result = evalExp(node->data.function.opList);
-            break;
-        case EXP2_FUNC:
-            result = evalExp2(node->data.function.opList);
-            break;
-        case POW_FUNC:
-            result = evalPow(node->data.function.opList);
-            break;
-        case LOG_FUNC:
-            result = evalLog(node->data.function.opList);
-            break;
-        case SQRT_FUNC:
-            result = evalSqrt(node->data.function.opList);
-            break;
-        case CBRT_FUNC:
-            result = evalCbrt(node->data.function.opList);
-            break;
-        case HYPOT_FUNC:
-            result = evalHypot(node->data.function.opList);
-            break;
-        case MAX_FUNC:
-            result = evalMax(node->data.function.opList);
-            break;
-        case MIN_FUNC:
-            result = evalMin(node->data.function.opList);
-            break;
-        case RAND_FUNC:
-            result = evalRand();
-            break;
-        case READ_FUNC:
-            result = evalRead();
-            break;
-        case EQUAL:
-            result = evalEqual(node->data.function.opList);
-            break;
-        case LESS:
-            result = evalLess(node->data.function.opList);
-            break;
-        case GREATER:
-            result = evalGreater(node->data.function.opList);
-            break;
-        case PRINT:
-            result = evalPrint(node->data.function.opList);
-            break;
-        case CUSTOM_FUNC:
-            result = evalCustomFunction(node->data.function.opList);
-        default:
-            warning("WARNING: Function not recognized!");
-
-
-    }
-
-    return result;
-}
-
-RET_VAL evalNumNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        yyerror("NULL ast node passed into evalNumNode!");
-        return NAN_RET_VAL;
-    }
-
-    // TODO complete the function finished
-
-    return node->data.number;
-}
-
-RET_VAL evalSymbolNode(AST_NODE *symbol)
-{
-    AST_NODE *scope = symbol;
-    if (!symbol)
-    {
-        yyerror("NULL ast node passed into evalSymbolNode!");
-        return NAN_RET_VAL;
-    }
-    RET_VAL result;
-
-    while(scope != NULL)
-    {
-        SYMBOL_TABLE_NODE *current = scope->symbolTable;
-        while(current)
-        {
-            if(strcmp(current->id, symbol->data.symbol.id) == 0)
-            {
-                result = eval(current->value);
-                if(current->value->type != NUM_NODE_TYPE)
-                {
-                    current->value->type = NUM_NODE_TYPE;
-                    current->value->data.number = result;
-                }
-
-                if(result.type == DOUBLE_TYPE && current->type == INT_TYPE)
-                {
-                    warning("Precision loss on int cast from %lf to %d", result.value, (int)round(result.value));
-                    result.type = INT_TYPE;
-                    result.value = round(result.value);
-                }
-                else if(result.type == INT_TYPE && current->type == DOUBLE_TYPE)
-                {
-                    result.type = DOUBLE_TYPE;
-                }
-                /// free Node
-                return result;
-            }
-            else
-            {
-                current = current->next;
-            }
-        }
-        scope = scope->parent;
-    }
-
-    warning("Undefined Symbol \"%s\" evaluated! NAN returned!", symbol->data.symbol.id);
-    return NAN_RET_VAL;
-
-
-}
-
-RET_VAL evalCondNode(AST_NODE *node)
-{
-    RET_VAL result;
-
-    if(!node)
-    {
-        warning("NULL ast node passed into evalCondNode!");
-        return NAN_RET_VAL;
-    }
-    else if(!node->data.conditional.condition || !node->data.conditional.ifFalse || !node->data.conditional.ifTrue)
-    {
-        warning("Not enough expressions in evalCondNode!");
-        return NAN_RET_VAL;
-    }
-    result = eval(node->data.conditional.condition);
-    if(result.value != 0)
-        result.value = node->data.conditional.ifTrue->data.number.value;
-    else
-        result.value = node->data.conditional.ifFalse->data.number.value;
-
-    result.type = INT_TYPE;
-    return result;
-
-}
-
-RET_VAL eval(AST_NODE *node)
-{
-    if (!node)
-    {
-        yyerror("NULL ast node passed into eval!");
-        return NAN_RET_VAL;
-    }
-
-    // TODO complete the function finished
-    switch (node->type) {
-        case NUM_NODE_TYPE:
-            return evalNumNode(node);
-        case FUNC_NODE_TYPE:
-            return evalFuncNode(node);
-        case SCOPE_NODE_TYPE:
-            return eval(node->data.scope.child);
-        case SYM_NODE_TYPE:
-            return evalSymbolNode(node);
-        case COND_NODE_TYPE:
-            return evalCondNode(node);
-        default:
-            yyerror("TYPE not recognized!");
-            return NAN_RET_VAL;
-
-    }
-
-
-}
-
-// prints the type and value of a RET_VAL
-void printRetVal(RET_VAL val)
-{
-    switch (val.type)
-    {
-        case INT_TYPE:
-            printf("Integer : %.lf\n", val.value);
-            break;
-        case DOUBLE_TYPE:
-            printf("Double : %lf\n", val.value);
-            break;
-        default:
-            printf("No Type : %lf\n", val.value);
-            break;
-    }
-}
-// TODO NEEDS DEBUGGING
-void freeFunctionNode(AST_NODE *function)
-{
-    freeNode(function->data.function.opList);
-}
-
-void freeSymbolTableNode(AST_NODE *symbol)
-{
-    freeNode(symbol->symbolTable->value);
-}
-
-// TODO - DEBUGGING
-void freeNode(AST_NODE *node)
-{
-    if (!node)
-    {
-        return;
-    }
-
-    if(node->type == FUNC_NODE_TYPE){
-        freeFunctionNode(node);
-    }
-//    if(node->type == SYM_NODE_TYPE){
-//        freeSymbolTableNode(node);
-//    }
-    freeNode(node->next);
-    free(node);
-
-
-
-}
-
-
-
-#line 2 "lex.yy.c"
-
-#define  YY_INT_ALIGNED short int
-
-/* A lexical scanner generated by flex */
-
-#define FLEX_SCANNER
-#define YY_FLEX_MAJOR_VERSION 2
-#define YY_FLEX_MINOR_VERSION 6
-#define YY_FLEX_SUBMINOR_VERSION 4
-#if YY_FLEX_SUBMINOR_VERSION > 0
-#define FLEX_BETA
-#endif
-
-/* First, we deal with  platform-specific or compiler-specific issues. */
-
-/* begin standard C headers. */
-#include <stdio.h>
-#include <string.h>
-#include <errno.h>
-#include <stdlib.h>
-
-/* end standard C headers. */
-
-/* flex integer type definitions */
-
-#ifndef FLEXINT_H
-#define FLEXINT_H
-
-/* C99 systems have <inttypes.h>. Non-C99 systems may or may not. */
-
-#if defined (__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
-
-/* C99 says to define __STDC_LIMIT_MACROS before including stdint.h,
- * if you want the limit (max/min) macros for int types. 
- */
-#ifndef __STDC_LIMIT_MACROS
-#define __STDC_LIMIT_MACROS 1
-#endif
-
-#include <inttypes.h>
-typedef int8_t flex_int8_t;
-typedef uint8_t flex_uint8_t;
-typedef int16_t flex_int16_t;
-typedef uint16_t flex_uint16_t;
-typedef int32_t flex_int32_t;
-typedef uint32_t flex_uint32_t;
-typedef uint64_t flex_uint64_t;
-#else
-typedef signed char flex_int8_t;
-typedef short int flex_int16_t;
-typedef int flex_int32_t;
-typedef unsigned char flex_uint8_t; 
-typedef unsigned short int flex_uint16_t;
-typedef unsigned int flex_uint32_t;
-
-/* Limits of integral types. */
-#ifndef INT8_MIN
-#define INT8_MIN               (-128)
-#endif
-#ifndef INT16_MIN
-#define INT16_MIN              (-32767-1)
-#endif
-#ifndef INT32_MIN
-#define INT32_MIN              (-2147483647-1)
-#endif
-#ifndef INT8_MAX
-#define INT8_MAX               (127)
-#endif
-#ifndef INT16_MAX
-#define INT16_MAX              (32767)
-#endif
-#ifndef INT32_MAX
-#define INT32_MAX              (2147483647)
-#endif
-#ifndef UINT8_MAX
-#define UINT8_MAX              (255U)
-#endif
-#ifndef UINT16_MAX
-#define UINT16_MAX             (65535U)
-#endif
-#ifndef UINT32_MAX
-#define UINT32_MAX             (4294967295U)
-#endif
-
-#ifndef SIZE_MAX
-#define SIZE_MAX               (~(size_t)0)
-#endif
-
-#endif /* ! C99 */
-
-#endif /* ! FLEXINT_H */
-
-/* begin standard C++ headers. */
-
-/* TODO: this is always defined, so inline it */
-#define yyconst const
-
-#if defined(__GNUC__) && __GNUC__ >= 3
-#define yynoreturn __attribute__((__noreturn__))
-#else
-#define yynoreturn
-#endif
-
-/* Returned upon end-of-file. */
-#define YY_NULL 0
-
-/* Promotes a possibly negative, possibly signed char to an
- *   integer in range [0..255] for use as an array index.
- */
-#define YY_SC_TO_UI(c) ((YY_CHAR) (c))
-
-/* Enter a start condition.  This macro really ought to take a parameter,
- * but we do it the disgusting crufty way forced on us by the ()-less
- * definition of BEGIN.
- */
-#define BEGIN (yy_start) = 1 + 2 *
-/* Translate the current start state into a value that can be later handed
- * to BEGIN to return to the state.  The YYSTATE alias is for lex
- * compatibility.
- */
-#define YY_START (((yy_start) - 1) / 2)
-#define YYSTATE YY_START
-/* Action number for EOF rule of a given start state. */
-#define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
-/* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart( yyin  )
-#define YY_END_OF_BUFFER_CHAR 0
-
-/* Size of default input buffer. */
-#ifndef YY_BUF_SIZE
-#ifdef __ia64__
-/* On IA-64, the buffer size is 16k, not 8k.
- * Moreover, YY_BUF_SIZE is 2*YY_READ_BUF_SIZE in the general case.
- * Ditto for the __ia64__ case accordingly.
- */
-#define YY_BUF_SIZE 32768
-#else
-#define YY_BUF_SIZE 16384
-#endif /* __ia64__ */
-#endif
-
-/* The state buf must be large enough to hold one state per character in the main buffer.
- */
-#define YY_STATE_BUF_SIZE   ((YY_BUF_SIZE + 2) * sizeof(yy_state_type))
-
-#ifndef YY_TYPEDEF_YY_BUFFER_STATE
-#define YY_TYPEDEF_YY_BUFFER_STATE
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
-#endif
-
-#ifndef YY_TYPEDEF_YY_SIZE_T
-#define YY_TYPEDEF_YY_SIZE_T
-typedef size_t yy_size_t;
-#endif
-
-extern yy_size_t yyleng;
-
-extern FILE *yyin, *yyout;
-
-#define EOB_ACT_CONTINUE_SCAN 0
-#define EOB_ACT_END_OF_FILE 1
-#define EOB_ACT_LAST_MATCH 2
-    
-    #define YY_LESS_LINENO(n)
-    #define YY_LINENO_REWIND_TO(ptr)
-    
-/* Return all but the first "n" matched characters back to the input stream. */
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up yytext. */ \
-        int yyless_macro_arg = (n); \
-        YY_LESS_LINENO(yyless_macro_arg);\
-		*yy_cp = (yy_hold_char); \
-		YY_RESTORE_YY_MORE_OFFSET \
-		(yy_c_buf_p) = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
-		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
-		} \
-	while ( 0 )
-#define unput(c) yyunput( c, (yytext_ptr)  )
-
-#ifndef YY_STRUCT_YY_BUFFER_STATE
-#define YY_STRUCT_YY_BUFFER_STATE
-struct yy_buffer_state
-	{
-	FILE *yy_input_file;
-
-	char *yy_ch_buf;		/* input buffer */
-	char *yy_buf_pos;		/* current position in input buffer */
-
-	/* Size of input buffer in bytes, not including room for EOB
-	 * characters.
-	 */
-	int yy_buf_size;
-
-	/* Number of characters read into yy_ch_buf, not including EOB
-	 * characters.
-	 */
-	yy_size_t yy_n_chars;
-
-	/* Whether we "own" the buffer - i.e., we know we created it,
-	 * and can realloc() it to grow it, and should free() it to
-	 * delete it.
-	 */
-	int yy_is_our_buffer;
-
-	/* Whether this is an "interactive" input source; if so, and
-	 * if we're using stdio for input, then we want to use getc()
-	 * instead of fread(), to make sure we stop fetching input after
-	 * each newline.
-	 */
-	int yy_is_interactive;
-
-	/* Whether we're considered to be at the beginning of a line.
-	 * If so, '^' rules will be active on the next match, otherwise
-	 * not.
-	 */
-	int yy_at_bol;
-
-    int yy_bs_lineno; /**< The line count. */
-    int yy_bs_column; /**< The column count. */
-
-	/* Whether to try to fill the input buffer when we reach the
-	 * end of it.
-	 */
-	int yy_fill_buffer;
-
-	int yy_buffer_status;
-
-#define YY_BUFFER_NEW 0
-#define YY_BUFFER_NORMAL 1
-	/* When an EOF's been seen but there's still some text to process
-	 * then we mark the buffer as YY_EOF_PENDING, to indicate that we
-	 * shouldn't try reading from the input source any more.  We might
-	 * still have a bunch of tokens to match, though, because of
-	 * possible backing-up.
-	 *
-	 * When we actually see the EOF, we change the status to "new"
-	 * (via yyrestart()), so that the user can continue scanning by
-	 * just pointing yyin at a new input file.
-	 */
-#define YY_BUFFER_EOF_PENDING 2
-
-	};
-#endif /* !YY_STRUCT_YY_BUFFER_STATE */
-
-/* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = NULL; /**< Stack as an array. */
-
-/* We provide macros for accessing buffer states in case in the
- * future we want to put the buffer states in a more general
- * "scanner state".
- *
- * Returns the top of the stack, or NULL.
- */
-#define YY_CURRENT_BUFFER ( (yy_buffer_stack) \
-                          ? (yy_buffer_stack)[(yy_buffer_stack_top)] \
-                          : NULL)
-/* Same as previous macro, but useful when we know that the buffer stack is not
- * NULL or when we need an lvalue. For internal use only.
- */
-#define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
-
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static yy_size_t yy_n_chars;		/* number of characters read into yy_ch_buf */
-yy_size_t yyleng;
-
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = NULL;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
-
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
-
-void yyrestart ( FILE *input_file  );
-void yy_switch_to_buffer ( YY_BUFFER_STATE new_buffer  );
-YY_BUFFER_STATE yy_create_buffer ( FILE *file, int size  );
-void yy_delete_buffer ( YY_BUFFER_STATE b  );
-void yy_flush_buffer ( YY_BUFFER_STATE b  );
-void yypush_buffer_state ( YY_BUFFER_STATE new_buffer  );
-void yypop_buffer_state ( void );
-
-static void yyensure_buffer_stack ( void );
-static void yy_load_buffer_state ( void );
-static void yy_init_buffer ( YY_BUFFER_STATE b, FILE *file  );
-#define YY_FLUSH_BUFFER yy_flush_buffer( YY_CURRENT_BUFFER )
-
-YY_BUFFER_STATE yy_scan_buffer ( char *base, yy_size_t size  );
-YY_BUFFER_STATE yy_scan_string ( const char *yy_str  );
-YY_BUFFER_STATE yy_scan_bytes ( const char *bytes, yy_size_t len  );
-
-void *yyalloc ( yy_size_t  );
-void *yyrealloc ( void *, yy_size_t  );
-void yyfree ( void *  );
-
-#define yy_new_buffer yy_create_buffer
-#define yy_set_interactive(is_interactive) \
-	{ \
-	if ( ! YY_CURRENT_BUFFER ){ \
-        yyensure_buffer_stack (); \
-		YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	} \
-	YY_CURRENT_BUFFER_LVALUE->yy_is_interactive = is_interactive; \
-	}
-#define yy_set_bol(at_bol) \
-	{ \
-	if ( ! YY_CURRENT_BUFFER ){\
-        yyensure_buffer_stack (); \
-		YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	} \
-	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = at_bol; \
-	}
-#define YY_AT_BOL() (YY_CURRENT_BUFFER_LVALUE->yy_at_bol)
-
-/* Begin user sect3 */
-
-#define yywrap() (/*CONSTCOND*/1)
-#define YY_SKIP_YYWRAP
-typedef flex_uint8_t YY_CHAR;
-
-FILE *yyin = NULL, *yyout = NULL;
-
-typedef int yy_state_type;
-
-extern int yylineno;
-int yylineno = 1;
-
-extern char *yytext;
-#ifdef yytext_ptr
-#undef yytext_ptr
-#endif
-#define yytext_ptr yytext
-
-static yy_state_type yy_get_previous_state ( void );
-static yy_state_type yy_try_NUL_trans ( yy_state_type current_state  );
-static int yy_get_next_buffer ( void );
-static void yynoreturn yy_fatal_error ( const char* msg  );
-
-/* Done after the current pattern has been matched and before the
- * corresponding action - sets up yytext.
- */
-#define YY_DO_BEFORE_ACTION \
-	(yytext_ptr) = yy_bp; \
-	yyleng = (yy_size_t) (yy_cp - yy_bp); \
-	(yy_hold_char) = *yy_cp; \
-	*yy_cp = '\0'; \
-	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 16
-#define YY_END_OF_BUFFER 17
-/* This struct is not used in this scanner,
-   but its presence is necessary. */
-struct yy_trans_info
-	{
-	flex_int32_t yy_verify;
-	flex_int32_t yy_nxt;
-	};
-static const flex_int16_t yy_accept[95] =
-    {   0,
-        0,    0,   17,   15,   14,   10,    9,   12,   13,   15,
-        1,    9,    9,    9,    9,    9,    9,    9,    9,    9,
-        9,    9,    9,    9,    9,   11,    9,    1,    2,    9,
-        9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
-        9,    9,    9,    9,    9,    9,    9,    9,    9,    9,
-        9,    9,    9,    9,    2,    8,    9,    9,    9,    9,
-        8,    9,    9,    7,    9,    9,    3,    8,    9,    9,
-        9,    9,    9,    9,    9,    6,    9,    9,    9,    9,
-        9,    9,    4,    9,    9,    9,    9,    9,    9,    5,
-        9,    9,    9,    0
-
-    } ;
-
-static const YY_CHAR yy_ec[256] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    2,    3,
-        1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    1,    1,    4,    1,    1,    1,    5,
-        6,    1,    7,    1,    7,    8,    1,    9,    9,   10,
-        9,    9,    9,    9,    9,    9,    9,    1,    1,    1,
-        1,    1,    1,    1,    4,    4,    4,    4,    4,    4,
-        4,    4,    4,    4,    4,    4,    4,    4,    4,    4,
-        4,    4,    4,    4,    4,    4,    4,    4,    4,    4,
-        1,    1,    1,    1,    4,    1,   11,   12,   13,   14,
-
-       15,    4,   16,   17,   18,    4,    4,   19,   20,   21,
-       22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
-       32,    4,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,   33
-    } ;
-
-static const YY_CHAR yy_meta[34] =
-    {   0,
-        1,    1,    1,    2,    1,    1,    1,    1,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    1
-    } ;
-
-static const flex_int16_t yy_base[96] =
-    {   0,
-        0,    0,  130,  131,  131,  131,    0,  131,  131,   25,
-       28,   27,   28,   24,   20,  104,   96,  106,   32,   34,
-      111,   31,   97,   44,   33,  131,    0,   55,   39,   98,
-      109,   97,  100,   91,   91,   90,   94,  101,   92,   87,
-       93,   40,   96,   80,   89,   90,   92,   77,   88,   87,
-       83,   49,   78,   90,   61,    0,   74,   86,   87,   87,
-       87,   85,   73,    0,   82,   67,    0,    0,   65,   70,
-       63,   75,   74,   76,   59,    0,   66,   65,   56,   55,
-       67,   53,    0,   61,   63,   62,   65,   54,   49,    0,
-       59,   57,   43,  131,   56
-
-    } ;
-
-static const flex_int16_t yy_def[96] =
-    {   0,
-       94,    1,   94,   94,   94,   94,   95,   94,   94,   94,
-       94,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   95,   94,   95,   94,   94,   95,
-       95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   94,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,   95,   95,   95,   95,   95,   95,   95,
-       95,   95,   95,    0,   94
-
-    } ;
-
-static const flex_int16_t yy_nxt[165] =
-    {   0,
-        4,    5,    6,    7,    8,    9,   10,    4,   11,   11,
-       12,    7,   13,   14,   15,   16,   17,   18,   19,   20,
-       21,    7,   22,   23,   24,   25,    7,    7,    7,    7,
-        7,    7,   26,   28,   28,   29,   28,   28,   30,   32,
-       31,   34,   41,   36,   44,   35,   42,   55,   55,   33,
-       37,   45,   48,   43,   51,   49,   53,   27,   52,   73,
-       54,   46,   29,   28,   28,   66,   67,   56,   74,   55,
-       55,   93,   92,   56,   91,   90,   89,   64,   88,   56,
-       87,   56,   86,   56,   85,   68,   84,   56,   56,   83,
-       82,   56,   56,   81,   80,   79,   56,   78,   77,   76,
-
-       56,   56,   75,   72,   71,   70,   56,   56,   69,   56,
-       56,   68,   65,   64,   63,   62,   61,   60,   59,   56,
-       58,   57,   56,   56,   50,   47,   40,   39,   38,   94,
-        3,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94
-    } ;
-
-static const flex_int16_t yy_chk[165] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,   10,   10,   11,   11,   11,   12,   13,
-       12,   14,   19,   15,   20,   14,   19,   29,   29,   13,
-       15,   20,   22,   19,   24,   22,   25,   95,   24,   52,
-       25,   20,   28,   28,   28,   42,   42,   93,   52,   55,
-       55,   92,   91,   89,   88,   87,   86,   85,   84,   82,
-       81,   80,   79,   78,   77,   75,   74,   73,   72,   71,
-       70,   69,   66,   65,   63,   62,   61,   60,   59,   58,
-
-       57,   54,   53,   51,   50,   49,   48,   47,   46,   45,
-       44,   43,   41,   40,   39,   38,   37,   36,   35,   34,
-       33,   32,   31,   30,   23,   21,   18,   17,   16,    3,
-       94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94,   94,   94,   94,   94,   94,   94,
-       94,   94,   94,   94
-    } ;
-
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
-extern int yy_flex_debug;
-int yy_flex_debug = 0;
-
-/* The intent behind this definition is that it'll catch
- * any uses of REJECT which flex missed.
- */
-#define REJECT reject_used_but_not_detected
-#define yymore() yymore_used_but_not_detected
-#define YY_MORE_ADJ 0
-#define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
-#line 1 "cilisp.l"
-#define YY_NO_INPUT 1
-#line 7 "cilisp.l"
-    #include "cilisp.h"
-    #define llog(token) {fprintf(flex_bison_log_file, "LEX: %s \"%s\"\n", #token, yytext); fflush(stdout);}
-#line 515 "lex.yy.c"
-#line 516 "lex.yy.c"
-
-#define INITIAL 0
-
-#ifndef YY_NO_UNISTD_H
-/* Special case for "unistd.h", since it is non-ANSI. We include it way
- * down here because we want the user's section 1 to have been scanned first.
- * The user has a chance to override it with an option.
- */
-#include <unistd.h>
-#endif
-
-#ifndef YY_EXTRA_TYPE
-#define YY_EXTRA_TYPE void *
-#endif
-
-static int yy_init_globals ( void );
-
-/* Accessor methods to globals.
-   These are made visible to non-reentrant scanners for convenience. */
-
-int yylex_destroy ( void );
-
-int yyget_debug ( void );
-
-void yyset_debug ( int debug_flag  );
-
-YY_EXTRA_TYPE yyget_extra ( void );
-
-void yyset_extra ( YY_EXTRA_TYPE user_defined  );
-
-FILE *yyget_in ( void );
-
-void yyset_in  ( FILE * _in_str  );
-
-FILE *yyget_out ( void );
-
-void yyset_out  ( FILE * _out_str  );
-
-			yy_size_t yyget_leng ( void );
-
-char *yyget_text ( void );
-
-int yyget_lineno ( void );
-
-void yyset_lineno ( int _line_number  );
-
-/* Macros after this point can all be overridden by user definitions in
- * section 1.
- */
-
-#ifndef YY_SKIP_YYWRAP
-#ifdef __cplusplus
-extern "C" int yywrap ( void );
-#else
-extern int yywrap ( void );
-#endif
-#endif
-
-#ifndef YY_NO_UNPUT
-    
-#endif
-
-#ifndef yytext_ptr
-static void yy_flex_strncpy ( char *, const char *, int );
-#endif
-
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen ( const char * );
-#endif
-
-#ifndef YY_NO_INPUT
-#ifdef __cplusplus
-static int yyinput ( void );
-#else
-static int input ( void );
-#endif
-
-#endif
-
-/* Amount of stuff to slurp up with each read. */
-#ifndef YY_READ_BUF_SIZE
-#ifdef __ia64__
-/* On IA-64, the buffer size is 16k, not 8k */
-#define YY_READ_BUF_SIZE 16384
-#else
-#define YY_READ_BUF_SIZE 8192
-#endif /* __ia64__ */
-#endif
-
-/* Copy whatever the last rule matched to the standard output. */
-#ifndef ECHO
-/* This used to be an fputs(), but since the string might contain NUL's,
- * we now use fwrite().
- */
-#define ECHO do { if (fwrite( yytext, (size_t) yyleng, 1, yyout )) {} } while (0)
-#endif
-
-/* Gets input and stuffs it into "buf".  number of characters read, or YY_NULL,
- * is returned in "result".
- */
-#ifndef YY_INPUT
-#define YY_INPUT(buf,result,max_size) \
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_is_interactive ) \
-		{ \
-		int c = '*'; \
-		yy_size_t n; \
-		for ( n = 0; n < max_size && \
-			     (c = getc( yyin )) != EOF && c != '\n'; ++n ) \
-			buf[n] = (char) c; \
-		if ( c == '\n' ) \
-			buf[n++] = (char) c; \
-		if ( c == EOF && ferror( yyin ) ) \
-			YY_FATAL_ERROR( "input in flex scanner failed" ); \
-		result = n; \
-		} \
-	else \
-		{ \
-		errno=0; \
-		while ( (result = (int) fread(buf, 1, (yy_size_t) max_size, yyin)) == 0 && ferror(yyin)) \
-			{ \
-			if( errno != EINTR) \
-				{ \
-				YY_FATAL_ERROR( "input in flex scanner failed" ); \
-				break; \
-				} \
-			errno=0; \
-			clearerr(yyin); \
-			} \
-		}\
-\
-
-#endif
-
-/* No semi-colon after return; correct usage is to write "yyterminate();" -
- * we don't want an extra ';' after the "return" because that will cause
- * some compilers to complain about unreachable statements.
- */
-#ifndef yyterminate
-#define yyterminate() return YY_NULL
-#endif
-
-/* Number of entries by which start-condition stack grows. */
-#ifndef YY_START_STACK_INCR
-#define YY_START_STACK_INCR 25
-#endif
-
-/* Report a fatal error. */
-#ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
-#endif
-
-/* end tables serialization structures and prototypes */
-
-/* Default declaration of generated scanner - a define so the user can
- * easily add parameters.
- */
-#ifndef YY_DECL
-#define YY_DECL_IS_OURS 1
-
-extern int yylex (void);
-
-#define YY_DECL int yylex (void)
-#endif /* !YY_DECL */
-
-/* Code executed at the beginning of each rule, after yytext and yyleng
- * have been set up.
- */
-#ifndef YY_USER_ACTION
-#define YY_USER_ACTION
-#endif
-
-/* Code executed at the end of each rule. */
-#ifndef YY_BREAK
-#define YY_BREAK /*LINTED*/break;
-#endif
-
-#define YY_RULE_SETUP \
-	YY_USER_ACTION
-
-/** The main scanner function which does all the work.
- */
-YY_DECL
-{
-	yy_state_type yy_current_state;
-	char *yy_cp, *yy_bp;
-	int yy_act;
-    
-	if ( !(yy_init) )
-		{
-		(yy_init) = 1;
-
-#ifdef YY_USER_INIT
-		YY_USER_INIT;
-#endif
-
-		if ( ! (yy_start) )
-			(yy_start) = 1;	/* first start state */
-
-		if ( ! yyin )
-			yyin = stdin;
-
-		if ( ! yyout )
-			yyout = stdout;
-
-		if ( ! YY_CURRENT_BUFFER ) {
-			yyensure_buffer_stack ();
-			YY_CURRENT_BUFFER_LVALUE =
-				yy_create_buffer( yyin, YY_BUF_SIZE );
-		}
-
-		yy_load_buffer_state(  );
-		}
-
-	{
-#line 24 "cilisp.l"
-
-
-#line 734 "lex.yy.c"
-
-	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
-		{
-		yy_cp = (yy_c_buf_p);
-
-		/* Support of yytext. */
-		*yy_cp = (yy_hold_char);
-
-		/* yy_bp points to the position in yy_ch_buf of the start of
-		 * the current run.
-		 */
-		yy_bp = yy_cp;
-
-		yy_current_state = (yy_start);
-yy_match:
-		do
-			{
-			YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)] ;
-			if ( yy_accept[yy_current_state] )
-				{
-				(yy_last_accepting_state) = yy_current_state;
-				(yy_last_accepting_cpos) = yy_cp;
-				}
-			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-				{
-				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 95 )
-					yy_c = yy_meta[yy_c];
-				}
-			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-			++yy_cp;
-			}
-		while ( yy_base[yy_current_state] != 131 );
-
-yy_find_action:
-		yy_act = yy_accept[yy_current_state];
-		if ( yy_act == 0 )
-			{ /* have to back up */
-			yy_cp = (yy_last_accepting_cpos);
-			yy_current_state = (yy_last_accepting_state);
-			yy_act = yy_accept[yy_current_state];
-			}
-
-		YY_DO_BEFORE_ACTION;
-
-do_action:	/* This label is used only to access EOF actions. */
-
-		switch ( yy_act )
-	{ /* beginning of action switch */
-			case 0: /* must back up */
-			/* undo the effects of YY_DO_BEFORE_ACTION */
-			*yy_cp = (yy_hold_char);
-			yy_cp = (yy_last_accepting_cpos);
-			yy_current_state = (yy_last_accepting_state);
-			goto yy_find_action;
-
-case 1:
-YY_RULE_SETUP
-#line 26 "cilisp.l"
-{
-    llog(INT);
-    yylval.dval = strtod(yytext, NULL);
-    return INT;
-}
-	YY_BREAK
-case 2:
-YY_RULE_SETUP
-#line 32 "cilisp.l"
-{
-    llog(DOUBLE);
-    yylval.dval = strtod(yytext, NULL);
-    return DOUBLE;
-}
-	YY_BREAK
-case 3:
-YY_RULE_SETUP
-#line 38 "cilisp.l"
-{
-    llog(LET);
-    return LET;
-}
-	YY_BREAK
-case 4:
-YY_RULE_SETUP
-#line 43 "cilisp.l"
-{
-    llog(QUIT);
-    return QUIT;
-}
-	YY_BREAK
-case 5:
-YY_RULE_SETUP
-#line 48 "cilisp.l"
-{
-    llog(LAMBDA);
-    return LAMBDA;
-}
-	YY_BREAK
-case 6:
-YY_RULE_SETUP
-#line 53 "cilisp.l"
-{
-    llog(COND);
-    return COND;
-}
-	YY_BREAK
-case 7:
-YY_RULE_SETUP
-#line 58 "cilisp.l"
-{
-    llog(TYPE);
-    yylval.ival = resolveType(yytext);
-    return TYPE;
-}
-	YY_BREAK
-case 8:
-YY_RULE_SETUP
-#line 64 "cilisp.l"
-{
-    llog(FUNC);
-    yylval.ival = resolveFunc(yytext);
-    return FUNC;
-}
-	YY_BREAK
-case 9:
-YY_RULE_SETUP
-#line 72 "cilisp.l"
-{
-    llog(SYMBOL);
-    yylval.cval = (char *) malloc((strlen(yytext) + 1) *sizeof(char));
-    strcpy(yylval.cval, yytext);
-    return SYMBOL;
-}
-	YY_BREAK
-case 10:
-/* rule 10 can match eol */
-YY_RULE_SETUP
-#line 81 "cilisp.l"
-{
-    llog(EOL);
-    return EOL;
-    }
-	YY_BREAK
-case 11:
-YY_RULE_SETUP
-#line 86 "cilisp.l"
-{
-    llog(EOFT);
-    return EOFT;
-    }
-	YY_BREAK
-case 12:
-YY_RULE_SETUP
-#line 91 "cilisp.l"
-{
-    llog(LPAREN);
-    return LPAREN;
-}
-	YY_BREAK
-case 13:
-YY_RULE_SETUP
-#line 96 "cilisp.l"
-{
-    llog(RPAREN);
-    return RPAREN;
-}
-	YY_BREAK
-case 14:
-YY_RULE_SETUP
-#line 101 "cilisp.l"
-; /* skip whitespace */
-	YY_BREAK
-case 15:
-YY_RULE_SETUP
-#line 103 "cilisp.l"
-{ // anything else
-    llog(INVALID);
-    warning("Invalid character >>%s<<", yytext);
-    }
-	YY_BREAK
-case 16:
-YY_RULE_SETUP
-#line 108 "cilisp.l"
-ECHO;
-	YY_BREAK
-#line 920 "lex.yy.c"
-case YY_STATE_EOF(INITIAL):
-	yyterminate();
-
-	case YY_END_OF_BUFFER:
-		{
-		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - (yytext_ptr)) - 1;
-
-		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = (yy_hold_char);
-		YY_RESTORE_YY_MORE_OFFSET
-
-		if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_NEW )
-			{
-			/* We're scanning a new file or input source.  It's
-			 * possible that this happened because the user
-			 * just pointed yyin at a new source and called
-			 * yylex().  If so, then we have to assure
-			 * consistency between YY_CURRENT_BUFFER and our
-			 * globals.  Here is the right place to do so, because
-			 * this is the first action (other than possibly a
-			 * back-up) that will match for the new input source.
-			 */
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-			YY_CURRENT_BUFFER_LVALUE->yy_input_file = yyin;
-			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status = YY_BUFFER_NORMAL;
-			}
-
-		/* Note that here we test for yy_c_buf_p "<=" to the position
-		 * of the first EOB in the buffer, since yy_c_buf_p will
-		 * already have been incremented past the NUL character
-		 * (since all states make transitions on EOB to the
-		 * end-of-buffer state).  Contrast this with the test
-		 * in input().
-		 */
-		if ( (yy_c_buf_p) <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
-			{ /* This was really a NUL. */
-			yy_state_type yy_next_state;
-
-			(yy_c_buf_p) = (yytext_ptr) + yy_amount_of_matched_text;
-
-			yy_current_state = yy_get_previous_state(  );
-
-			/* Okay, we're now positioned to make the NUL
-			 * transition.  We couldn't have
-			 * yy_get_previous_state() go ahead and do it
-			 * for us because it doesn't know how to deal
-			 * with the possibility of jamming (and we don't
-			 * want to build jamming into it because then it
-			 * will run more slowly).
-			 */
-
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
-
-			yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-
-			if ( yy_next_state )
-				{
-				/* Consume the NUL. */
-				yy_cp = ++(yy_c_buf_p);
-				yy_current_state = yy_next_state;
-				goto yy_match;
-				}
-
-			else
-				{
-				yy_cp = (yy_c_buf_p);
-				goto yy_find_action;
-				}
-			}
-
-		else switch ( yy_get_next_buffer(  ) )
-			{
-			case EOB_ACT_END_OF_FILE:
-				{
-				(yy_did_buffer_switch_on_eof) = 0;
-
-				if ( yywrap(  ) )
-					{
-					/* Note: because we've taken care in
-					 * yy_get_next_buffer() to have set up
-					 * yytext, we can now set up
-					 * yy_c_buf_p so that if some total
-					 * hoser (like flex itself) wants to
-					 * call the scanner after we return the
-					 * YY_NULL, it'll still work - another
-					 * YY_NULL will get returned.
-					 */
-					(yy_c_buf_p) = (yytext_ptr) + YY_MORE_ADJ;
-
-					yy_act = YY_STATE_EOF(YY_START);
-					goto do_action;
-					}
-
-				else
-					{
-					if ( ! (yy_did_buffer_switch_on_eof) )
-						YY_NEW_FILE;
-					}
-				break;
-				}
-
-			case EOB_ACT_CONTINUE_SCAN:
-				(yy_c_buf_p) =
-					(yytext_ptr) + yy_amount_of_matched_text;
-
-				yy_current_state = yy_get_previous_state(  );
-
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-				goto yy_match;
-
-			case EOB_ACT_LAST_MATCH:
-				(yy_c_buf_p) =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)];
-
-				yy_current_state = yy_get_previous_state(  );
-
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-				goto yy_find_action;
-			}
-		break;
-		}
-
-	default:
-		YY_FATAL_ERROR(
-			"fatal flex scanner internal error--no action found" );
-	} /* end of action switch */
-		} /* end of scanning one token */
-	} /* end of user's declarations */
-} /* end of yylex */
-
-/* yy_get_next_buffer - try to read in a new buffer
- *
- * Returns a code representing an action:
- *	EOB_ACT_LAST_MATCH -
- *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
- *	EOB_ACT_END_OF_FILE - end of file
- */
-static int yy_get_next_buffer (void)
-{
-    	char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
-	char *source = (yytext_ptr);
-	int number_to_move, i;
-	int ret_val;
-
-	if ( (yy_c_buf_p) > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] )
-		YY_FATAL_ERROR(
-		"fatal flex scanner internal error--end of buffer missed" );
-
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_fill_buffer == 0 )
-		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( (yy_c_buf_p) - (yytext_ptr) - YY_MORE_ADJ == 1 )
-			{
-			/* We matched a single character, the EOB, so
-			 * treat this as a final EOF.
-			 */
-			return EOB_ACT_END_OF_FILE;
-			}
-
-		else
-			{
-			/* We matched some text prior to the EOB, first
-			 * process it.
-			 */
-			return EOB_ACT_LAST_MATCH;
-			}
-		}
-
-	/* Try to read more data. */
-
-	/* First move last chars to start of buffer. */
-	number_to_move = (int) ((yy_c_buf_p) - (yytext_ptr) - 1);
-
-	for ( i = 0; i < number_to_move; ++i )
-		*(dest++) = *(source++);
-
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_EOF_PENDING )
-		/* don't do the read, it's not guaranteed to return an EOF,
-		 * just force an EOF
-		 */
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars) = 0;
-
-	else
-		{
-			yy_size_t num_to_read =
-			YY_CURRENT_BUFFER_LVALUE->yy_buf_size - number_to_move - 1;
-
-		while ( num_to_read <= 0 )
-			{ /* Not enough room in the buffer - grow it. */
-
-			/* just a shorter name for the current buffer */
-			YY_BUFFER_STATE b = YY_CURRENT_BUFFER_LVALUE;
-
-			int yy_c_buf_p_offset =
-				(int) ((yy_c_buf_p) - b->yy_ch_buf);
-
-			if ( b->yy_is_our_buffer )
-				{
-				yy_size_t new_size = b->yy_buf_size * 2;
-
-				if ( new_size <= 0 )
-					b->yy_buf_size += b->yy_buf_size / 8;
-				else
-					b->yy_buf_size *= 2;
-
-				b->yy_ch_buf = (char *)
-					/* Include room in for 2 EOB chars. */
-					yyrealloc( (void *) b->yy_ch_buf,
-							 (yy_size_t) (b->yy_buf_size + 2)  );
-				}
-			else
-				/* Can't grow it, we don't own it. */
-				b->yy_ch_buf = NULL;
-
-			if ( ! b->yy_ch_buf )
-				YY_FATAL_ERROR(
-				"fatal error - scanner input buffer overflow" );
-
-			(yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];
-
-			num_to_read = YY_CURRENT_BUFFER_LVALUE->yy_buf_size -
-						number_to_move - 1;
-
-			}
-
-		if ( num_to_read > YY_READ_BUF_SIZE )
-			num_to_read = YY_READ_BUF_SIZE;
-
-		/* Read in more data. */
-		YY_INPUT( (&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move]),
-			(yy_n_chars), num_to_read );
-
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	if ( (yy_n_chars) == 0 )
-		{
-		if ( number_to_move == YY_MORE_ADJ )
-			{
-			ret_val = EOB_ACT_END_OF_FILE;
-			yyrestart( yyin  );
-			}
-
-		else
-			{
-			ret_val = EOB_ACT_LAST_MATCH;
-			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status =
-				YY_BUFFER_EOF_PENDING;
-			}
-		}
-
-	else
-		ret_val = EOB_ACT_CONTINUE_SCAN;
-
-	if (((yy_n_chars) + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
-		/* Extend the array by 50%, plus the number we really need. */
-		yy_size_t new_size = (yy_n_chars) + number_to_move + ((yy_n_chars) >> 1);
-		YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) yyrealloc(
-			(void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf, (yy_size_t) new_size  );
-		if ( ! YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
-			YY_FATAL_ERROR( "out of dynamic memory in yy_get_next_buffer()" );
-		/* "- 2" to take care of EOB's */
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_size = (int) (new_size - 2);
-	}
-
-	(yy_n_chars) += number_to_move;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] = YY_END_OF_BUFFER_CHAR;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] = YY_END_OF_BUFFER_CHAR;
-
-	(yytext_ptr) = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
-
-	return ret_val;
-}
-
-/* yy_get_previous_state - get the state just before the EOB char was reached */
-
-    static yy_state_type yy_get_previous_state (void)
-{
-	yy_state_type yy_current_state;
-	char *yy_cp;
-    
-	yy_current_state = (yy_start);
-
-	for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
-		{
-		YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
-		if ( yy_accept[yy_current_state] )
-			{
-			(yy_last_accepting_state) = yy_current_state;
-			(yy_last_accepting_cpos) = yy_cp;
-			}
-		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-			{
-			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 95 )
-				yy_c = yy_meta[yy_c];
-			}
-		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-		}
-
-	return yy_current_state;
-}
-
-/* yy_try_NUL_trans - try to make a transition on the NUL character
- *
- * synopsis
- *	next_state = yy_try_NUL_trans( current_state );
- */
-    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
-{
-	int yy_is_jam;
-    	char *yy_cp = (yy_c_buf_p);
-
-	YY_CHAR yy_c = 1;
-	if ( yy_accept[yy_current_state] )
-		{
-		(yy_last_accepting_state) = yy_current_state;
-		(yy_last_accepting_cpos) = yy_cp;
-		}
-	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-		{
-		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 95 )
-			yy_c = yy_meta[yy_c];
-		}
-	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 94);
-
-		return yy_is_jam ? 0 : yy_current_state;
-}
-
-#ifndef YY_NO_UNPUT
-
-#endif
-
-#ifndef YY_NO_INPUT
-#ifdef __cplusplus
-    static int yyinput (void)
-#else
-    static int input  (void)
-#endif
-
-{
-	int c;
-    
-	*(yy_c_buf_p) = (yy_hold_char);
-
-	if ( *(yy_c_buf_p) == YY_END_OF_BUFFER_CHAR )
-		{
-		/* yy_c_buf_p now points to the character we want to return.
-		 * If this occurs *before* the EOB characters, then it's a
-		 * valid NUL; if not, then we've hit the end of the buffer.
-		 */
-		if ( (yy_c_buf_p) < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
-			/* This was really a NUL. */
-			*(yy_c_buf_p) = '\0';
-
-		else
-			{ /* need more input */
-			yy_size_t offset = (yy_c_buf_p) - (yytext_ptr);
-			++(yy_c_buf_p);
-
-			switch ( yy_get_next_buffer(  ) )
-				{
-				case EOB_ACT_LAST_MATCH:
-					/* This happens because yy_g_n_b()
-					 * sees that we've accumulated a
-					 * token and flags that we need to
-					 * try matching the token before
-					 * proceeding.  But for input(),
-					 * there's no matching to consider.
-					 * So convert the EOB_ACT_LAST_MATCH
-					 * to EOB_ACT_END_OF_FILE.
-					 */
-
-					/* Reset buffer status. */
-					yyrestart( yyin );
-
-					/*FALLTHROUGH*/
-
-				case EOB_ACT_END_OF_FILE:
-					{
-					if ( yywrap(  ) )
-						return 0;
-
-					if ( ! (yy_did_buffer_switch_on_eof) )
-						YY_NEW_FILE;
-#ifdef __cplusplus
-					return yyinput();
-#else
-					return input();
-#endif
-					}
-
-				case EOB_ACT_CONTINUE_SCAN:
-					(yy_c_buf_p) = (yytext_ptr) + offset;
-					break;
-				}
-			}
-		}
-
-	c = *(unsigned char *) (yy_c_buf_p);	/* cast for 8-bit char's */
-	*(yy_c_buf_p) = '\0';	/* preserve yytext */
-	(yy_hold_char) = *++(yy_c_buf_p);
-
-	return c;
-}
-#endif	/* ifndef YY_NO_INPUT */
-
-/** Immediately switch to a different input stream.
- * @param input_file A readable stream.
- * 
- * @note This function does not reset the start condition to @c INITIAL .
- */
-    void yyrestart  (FILE * input_file )
-{
-    
-	if ( ! YY_CURRENT_BUFFER ){
-        yyensure_buffer_stack ();
-		YY_CURRENT_BUFFER_LVALUE =
-            yy_create_buffer( yyin, YY_BUF_SIZE );
-	}
-
-	yy_init_buffer( YY_CURRENT_BUFFER, input_file );
-	yy_load_buffer_state(  );
-}
-
-/** Switch to a different input buffer.
- * @param new_buffer The new input buffer.
- * 
- */
-    void yy_switch_to_buffer  (YY_BUFFER_STATE  new_buffer )
-{
-    
-	/* TODO. We should be able to replace this entire function body
-	 * with
-	 *		yypop_buffer_state();
-	 *		yypush_buffer_state(new_buffer);
-     */
-	yyensure_buffer_stack ();
-	if ( YY_CURRENT_BUFFER == new_buffer )
-		return;
-
-	if ( YY_CURRENT_BUFFER )
-		{
-		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-	yy_load_buffer_state(  );
-
-	/* We don't actually know whether we did this switch during
-	 * EOF (yywrap()) processing, but the only time this flag
-	 * is looked at is after yywrap() is called, so it's safe
-	 * to go ahead and always set it.
-	 */
-	(yy_did_buffer_switch_on_eof) = 1;
-}
-
-static void yy_load_buffer_state  (void)
-{
-    	(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-	(yytext_ptr) = (yy_c_buf_p) = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
-	yyin = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
-	(yy_hold_char) = *(yy_c_buf_p);
-}
-
-/** Allocate and initialize an input buffer state.
- * @param file A readable stream.
- * @param size The character buffer size in bytes. When in doubt, use @c YY_BUF_SIZE.
- * 
- * @return the allocated buffer state.
- */
-    YY_BUFFER_STATE yy_create_buffer  (FILE * file, int  size )
-{
-	YY_BUFFER_STATE b;
-    
-	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state )  );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
-
-	b->yy_buf_size = size;
-
-	/* yy_ch_buf has to be 2 characters longer than the size given because
-	 * we need to put in 2 end-of-buffer characters.
-	 */
-	b->yy_ch_buf = (char *) yyalloc( (yy_size_t) (b->yy_buf_size + 2)  );
-	if ( ! b->yy_ch_buf )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
-
-	b->yy_is_our_buffer = 1;
-
-	yy_init_buffer( b, file );
-
-	return b;
-}
-
-/** Destroy the buffer.
- * @param b a buffer created with yy_create_buffer()
- * 
- */
-    void yy_delete_buffer (YY_BUFFER_STATE  b )
-{
-    
-	if ( ! b )
-		return;
-
-	if ( b == YY_CURRENT_BUFFER ) /* Not sure if we should pop here. */
-		YY_CURRENT_BUFFER_LVALUE = (YY_BUFFER_STATE) 0;
-
-	if ( b->yy_is_our_buffer )
-		yyfree( (void *) b->yy_ch_buf  );
-
-	yyfree( (void *) b  );
-}
-
-/* Initializes or reinitializes a buffer.
- * This function is sometimes called more than once on the same buffer,
- * such as during a yyrestart() or at EOF.
- */
-    static void yy_init_buffer  (YY_BUFFER_STATE  b, FILE * file )
-
-{
-	int oerrno = errno;
-    
-	yy_flush_buffer( b );
-
-	b->yy_input_file = file;
-	b->yy_fill_buffer = 1;
-
-    /* If b is the current buffer, then yy_init_buffer was _probably_
-     * called from yyrestart() or through yy_get_next_buffer.
-     * In that case, we don't want to reset the lineno or column.
-     */
-    if (b != YY_CURRENT_BUFFER){
-        b->yy_bs_lineno = 1;
-        b->yy_bs_column = 0;
-    }
-
-        b->yy_is_interactive = file ? (isatty( fileno(file) ) > 0) : 0;
-    
-	errno = oerrno;
-}
-
-/** Discard all buffered characters. On the next scan, YY_INPUT will be called.
- * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
- * 
- */
-    void yy_flush_buffer (YY_BUFFER_STATE  b )
-{
-    	if ( ! b )
-		return;
-
-	b->yy_n_chars = 0;
-
-	/* We always need two end-of-buffer characters.  The first causes
-	 * a transition to the end-of-buffer state.  The second causes
-	 * a jam in that state.
-	 */
-	b->yy_ch_buf[0] = YY_END_OF_BUFFER_CHAR;
-	b->yy_ch_buf[1] = YY_END_OF_BUFFER_CHAR;
-
-	b->yy_buf_pos = &b->yy_ch_buf[0];
-
-	b->yy_at_bol = 1;
-	b->yy_buffer_status = YY_BUFFER_NEW;
-
-	if ( b == YY_CURRENT_BUFFER )
-		yy_load_buffer_state(  );
-}
-
-/** Pushes the new state onto the stack. The new state becomes
- *  the current state. This function will allocate the stack
- *  if necessary.
- *  @param new_buffer The new state.
- *  
- */
-void yypush_buffer_state (YY_BUFFER_STATE new_buffer )
-{
-    	if (new_buffer == NULL)
-		return;
-
-	yyensure_buffer_stack();
-
-	/* This block is copied from yy_switch_to_buffer. */
-	if ( YY_CURRENT_BUFFER )
-		{
-		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	/* Only push if top exists. Otherwise, replace top. */
-	if (YY_CURRENT_BUFFER)
-		(yy_buffer_stack_top)++;
-	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-
-	/* copied from yy_switch_to_buffer. */
-	yy_load_buffer_state(  );
-	(yy_did_buffer_switch_on_eof) = 1;
-}
-
-/** Removes and deletes the top of the stack, if present.
- *  The next element becomes the new top.
- *  
- */
-void yypop_buffer_state (void)
-{
-    	if (!YY_CURRENT_BUFFER)
-		return;
-
-	yy_delete_buffer(YY_CURRENT_BUFFER );
-	YY_CURRENT_BUFFER_LVALUE = NULL;
-	if ((yy_buffer_stack_top) > 0)
-		--(yy_buffer_stack_top);
-
-	if (YY_CURRENT_BUFFER) {
-		yy_load_buffer_state(  );
-		(yy_did_buffer_switch_on_eof) = 1;
-	}
-}
-
-/* Allocates the stack if it does not exist.
- *  Guarantees space for at least one push.
- */
-static void yyensure_buffer_stack (void)
-{
-	yy_size_t num_to_alloc;
-    
-	if (!(yy_buffer_stack)) {
-
-		/* First allocation is just for 2 elements, since we don't know if this
-		 * scanner will even need a stack. We use 2 instead of 1 to avoid an
-		 * immediate realloc on the next call.
-         */
-      num_to_alloc = 1; /* After all that talk, this was set to 1 anyways... */
-		(yy_buffer_stack) = (struct yy_buffer_state**)yyalloc
-								(num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
-			YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
-
-		memset((yy_buffer_stack), 0, num_to_alloc * sizeof(struct yy_buffer_state*));
-
-		(yy_buffer_stack_max) = num_to_alloc;
-		(yy_buffer_stack_top) = 0;
-		return;
-	}
-
-	if ((yy_buffer_stack_top) >= ((yy_buffer_stack_max)) - 1){
-
-		/* Increase the buffer to prepare for a possible push. */
-		yy_size_t grow_size = 8 /* arbitrary grow size */;
-
-		num_to_alloc = (yy_buffer_stack_max) + grow_size;
-		(yy_buffer_stack) = (struct yy_buffer_state**)yyrealloc
-								((yy_buffer_stack),
-								num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
-			YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
-
-		/* zero only the new slots.*/
-		memset((yy_buffer_stack) + (yy_buffer_stack_max), 0, grow_size * sizeof(struct yy_buffer_state*));
-		(yy_buffer_stack_max) = num_to_alloc;
-	}
-}
-
-/** Setup the input buffer state to scan directly from a user-specified character buffer.
- * @param base the character buffer
- * @param size the size in bytes of the character buffer
- * 
- * @return the newly allocated buffer state object.
- */
-YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
-{
-	YY_BUFFER_STATE b;
-    
-	if ( size < 2 ||
-	     base[size-2] != YY_END_OF_BUFFER_CHAR ||
-	     base[size-1] != YY_END_OF_BUFFER_CHAR )
-		/* They forgot to leave room for the EOB's. */
-		return NULL;
-
-	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state )  );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
-
-	b->yy_buf_size = (int) (size - 2);	/* "- 2" to take care of EOB's */
-	b->yy_buf_pos = b->yy_ch_buf = base;
-	b->yy_is_our_buffer = 0;
-	b->yy_input_file = NULL;
-	b->yy_n_chars = b->yy_buf_size;
-	b->yy_is_interactive = 0;
-	b->yy_at_bol = 1;
-	b->yy_fill_buffer = 0;
-	b->yy_buffer_status = YY_BUFFER_NEW;
-
-	yy_switch_to_buffer( b  );
-
-	return b;
-}
-
-/** Setup the input buffer state to scan a string. The next call to yylex() will
- * scan from a @e copy of @a str.
- * @param yystr a NUL-terminated string to scan
- * 
- * @return the newly allocated buffer state object.
- * @note If you want to scan bytes that may contain NUL values, then use
- *       yy_scan_bytes() instead.
- */
-YY_BUFFER_STATE yy_scan_string (const char * yystr )
-{
-    
-	return yy_scan_bytes( yystr, (int) strlen(yystr) );
-}
-
-/** Setup the input buffer state to scan the given bytes. The next call to yylex() will
- * scan from a @e copy of @a bytes.
- * @param yybytes the byte buffer to scan
- * @param _yybytes_len the number of bytes in the buffer pointed to by @a bytes.
- * 
- * @return the newly allocated buffer state object.
- */
-YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, yy_size_t  _yybytes_len )
-{
-	YY_BUFFER_STATE b;
-	char *buf;
-	yy_size_t n;
-	yy_size_t i;
-    
-	/* Get memory for full buffer, including space for trailing EOB's. */
-	n = (yy_size_t) (_yybytes_len + 2);
-	buf = (char *) yyalloc( n  );
-	if ( ! buf )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_bytes()" );
-
-	for ( i = 0; i < _yybytes_len; ++i )
-		buf[i] = yybytes[i];
-
-	buf[_yybytes_len] = buf[_yybytes_len+1] = YY_END_OF_BUFFER_CHAR;
-
-	b = yy_scan_buffer( buf, n );
-	if ( ! b )
-		YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
-
-	/* It's okay to grow etc. this buffer, and we should throw it
-	 * away when we're done.
-	 */
-	b->yy_is_our_buffer = 1;
-
-	return b;
-}
-
-#ifndef YY_EXIT_FAILURE
-#define YY_EXIT_FAILURE 2
-#endif
-
-static void yynoreturn yy_fatal_error (const char* msg )
-{
-			fprintf( stderr, "%s\n", msg );
-	exit( YY_EXIT_FAILURE );
-}
-
-/* Redefine yyless() so it works in section 3 code. */
-
-#undef yyless
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up yytext. */ \
-        yy_size_t yyless_macro_arg = (n); \
-        YY_LESS_LINENO(yyless_macro_arg);\
-		yytext[yyleng] = (yy_hold_char); \
-		(yy_c_buf_p) = yytext + yyless_macro_arg; \
-		(yy_hold_char) = *(yy_c_buf_p); \
-		*(yy_c_buf_p) = '\0'; \
-		yyleng = yyless_macro_arg; \
-		} \
-	while ( 0 )
-
-/* Accessor  methods (get/set functions) to struct members. */
-
-/** Get the current line number.
- * 
- */
-int yyget_lineno  (void)
-{
-    
-    return yylineno;
-}
-
-/** Get the input stream.
- * 
- */
-FILE *yyget_in  (void)
-{
-        return yyin;
-}
-
-/** Get the output stream.
- * 
- */
-FILE *yyget_out  (void)
-{
-        return yyout;
-}
-
-/** Get the length of the current token.
- * 
- */
-yy_size_t yyget_leng  (void)
-{
-        return yyleng;
-}
-
-/** Get the current token.
- * 
- */
-
-char *yyget_text  (void)
-{
-        return yytext;
-}
-
-/** Set the current line number.
- * @param _line_number line number
- * 
- */
-void yyset_lineno (int  _line_number )
-{
-    
-    yylineno = _line_number;
-}
-
-/** Set the input stream. This does not discard the current
- * input buffer.
- * @param _in_str A readable stream.
- * 
- * @see yy_switch_to_buffer
- */
-void yyset_in (FILE *  _in_str )
-{
-        yyin = _in_str ;
-}
-
-void yyset_out (FILE *  _out_str )
-{
-        yyout = _out_str ;
-}
-
-int yyget_debug  (void)
-{
-        return yy_flex_debug;
-}
-
-void yyset_debug (int  _bdebug )
-{
-        yy_flex_debug = _bdebug ;
-}
-
-static int yy_init_globals (void)
-{
-        /* Initialization is the same as for the non-reentrant scanner.
-     * This function is called from yylex_destroy(), so don't allocate here.
-     */
-
-    (yy_buffer_stack) = NULL;
-    (yy_buffer_stack_top) = 0;
-    (yy_buffer_stack_max) = 0;
-    (yy_c_buf_p) = NULL;
-    (yy_init) = 0;
-    (yy_start) = 0;
-
-/* Defined in main.c */
-#ifdef YY_STDINIT
-    yyin = stdin;
-    yyout = stdout;
-#else
-    yyin = NULL;
-    yyout = NULL;
-#endif
-
-    /* For future reference: Set errno on error, since we are called by
-     * yylex_init()
-     */
-    return 0;
-}
-
-/* yylex_destroy is for both reentrant and non-reentrant scanners. */
-int yylex_destroy  (void)
-{
-    
-    /* Pop the buffer stack, destroying each element. */
-	while(YY_CURRENT_BUFFER){
-		yy_delete_buffer( YY_CURRENT_BUFFER  );
-		YY_CURRENT_BUFFER_LVALUE = NULL;
-		yypop_buffer_state();
-	}
-
-	/* Destroy the stack itself. */
-	yyfree((yy_buffer_stack) );
-	(yy_buffer_stack) = NULL;
-
-    /* Reset the globals. This is important in a non-reentrant scanner so the next time
-     * yylex() is called, initialization will occur. */
-    yy_init_globals( );
-
-    return 0;
-}
-
-/*
- * Internal utility routines.
- */
-
-#ifndef yytext_ptr
-static void yy_flex_strncpy (char* s1, const char * s2, int n )
-{
-		
-	int i;
-	for ( i = 0; i < n; ++i )
-		s1[i] = s2[i];
-}
-#endif
-
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (const char * s )
-{
-	int n;
-	for ( n = 0; s[n]; ++n )
-		;
-
-	return n;
-}
-#endif
-
-void *yyalloc (yy_size_t  size )
-{
-			return malloc(size);
-}
-
-void *yyrealloc  (void * ptr, yy_size_t  size )
-{
-		
-	/* The cast to (char *) in the following accommodates both
-	 * implementations that use char* generic pointers, and those
-	 * that use void* generic pointers.  It works with the latter
-	 * because both ANSI C and C++ allow castless assignment from
-	 * any pointer type to void*, and deal with argument conversions
-	 * as though doing an assignment.
-	 */
-	return realloc(ptr, size);
-}
-
-void yyfree (void * ptr )
-{
-			free( (char *) ptr );	/* see yyrealloc() for (char *) cast */
-}
-
-#define YYTABLES_NAME "yytables"
-
-#line 108 "cilisp.l"
-
-
-// Edit at your own risk.
-
-#include <stdio.h>
-#include "yyreadprint.c"
-
-int main(int argc, char **argv)
-{
-    flex_bison_log_file = fopen(BISON_FLEX_LOG_PATH, "w");
-
-    if (argc > 2) read_target = fopen(argv[2], "r");
-    else read_target = stdin;
-
-    bool input_from_file;
-    if ((input_from_file = argc > 1))
-    {
-        stdin = fopen(argv[1], "r");
-    }
-
-    char *s_expr_str = NULL;
-    size_t s_expr_str_len = 0;
-    size_t s_expr_postfix_padding = 2;
-    YY_BUFFER_STATE buffer;
-
-    while (true)
-    {
-        printf("\n> ");
-
-        s_expr_str = NULL;
-        s_expr_str_len = 0;
-        yyreadline(&s_expr_str, &s_expr_str_len, stdin, s_expr_postfix_padding);
-
-        while (s_expr_str[0] == '\n')
-        {
-            yyreadline(&s_expr_str, &s_expr_str_len, stdin, s_expr_postfix_padding);
-        }
-
-        if (input_from_file)
-        {
-            yyprintline(s_expr_str, s_expr_str_len, s_expr_postfix_padding);
-        }
-
-        buffer = yy_scan_buffer(s_expr_str, s_expr_str_len);
-
-        yyparse();
-
-        yy_flush_buffer(buffer);
-        yy_delete_buffer(buffer);
-        free(s_expr_str);
-    }
-}
-
-/* A Bison parser, made by GNU Bison 2.3.  */
-
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-
-   This program is free software; you can redistribute it and/or modify
-   it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
-
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-   GNU General Public License for more details.
-
-   You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
-
-/* As a special exception, you may create a larger work that contains
-   part or all of the Bison parser skeleton and distribute that work
-   under terms of your choice, so long as that work isn't itself a
-   parser generator using the skeleton or a modified version thereof
-   as a parser skeleton.  Alternatively, if you modify or redistribute
-   the parser skeleton itself, you may (at your option) remove this
-   special exception, which will cause the skeleton and the resulting
-   Bison output files to be licensed under the GNU General Public
-   License without this special exception.
-
-   This special exception was added by the Free Software Foundation in
-   version 2.2 of Bison.  */
-
-/* C LALR(1) parser skeleton written by Richard Stallman, by
-   simplifying the original so-called "semantic" parser.  */
-
-/* All symbols defined below should begin with yy or YY, to avoid
-   infringing on user name space.  This should be done even for local
-   variables, as they might otherwise be expanded by user macros.
-   There are some unavoidable exceptions within include files to
-   define necessary library symbols; they are noted "INFRINGES ON
-   USER NAME SPACE" below.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
-
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
-
-/* Skeleton name.  */
-#define YYSKELETON_NAME "yacc.c"
-
-/* Pure parsers.  */
-#define YYPURE 0
-
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     FUNC = 258,
-     TYPE = 259,
-     INT = 260,
-     DOUBLE = 261,
-     SYMBOL = 262,
-     QUIT = 263,
-     EOL = 264,
-     EOFT = 265,
-     COND = 266,
-     LPAREN = 267,
-     RPAREN = 268,
-     LET = 269,
-     LAMBDA = 270
-   };
-#endif
-/* Tokens.  */
-#define FUNC 258
-#define TYPE 259
-#define INT 260
-#define DOUBLE 261
-#define SYMBOL 262
-#define QUIT 263
-#define EOL 264
-#define EOFT 265
-#define COND 266
-#define LPAREN 267
-#define RPAREN 268
-#define LET 269
-#define LAMBDA 270
-
-
-
-
-/* Copy the first part of user declarations.  */
-#line 1 "cilisp.y"
-
-    #include "cilisp.h"
-    #define ylog(r, p) {printf("BISON: %s ::= %s \n", #r, #p);}
-    int yylex();
-    void yyerror(char*, ...);
-
-
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
-
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 8 "cilisp.y"
-{
-    char *ident;
-    double dval;
-    int ival;
-    struct ast_node *astNode;
-    struct symbol_table_node *symNode;
-}
-/* Line 193 of yacc.c.  */
-#line 141 "y.tab.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
-
-
-
-/* Copy the second part of user declarations.  */
-
-
-/* Line 216 of yacc.c.  */
-#line 154 "y.tab.c"
-
-#ifdef short
-# undef short
-#endif
-
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
-#endif
-
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
-#else
-typedef unsigned short int yytype_uint16;
-#endif
-
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
-#endif
-
-#ifndef YYSIZE_T
-# ifdef __SIZE_TYPE__
-#  define YYSIZE_T __SIZE_TYPE__
-# elif defined size_t
-#  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYSIZE_T size_t
-# else
-#  define YYSIZE_T unsigned int
-# endif
-#endif
-
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
-
-#ifndef YY_
-# if defined YYENABLE_NLS && YYENABLE_NLS
-#  if ENABLE_NLS
-#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
-#  endif
-# endif
-# ifndef YY_
-#  define YY_(msgid) msgid
-# endif
-#endif
-
-/* Suppress unused-variable warnings by "using" E.  */
-#if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
-#else
-# define YYUSE(e) /* empty */
-#endif
-
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
-#else
-static int
-YYID (i)
-    int i;
-#endif
-{
-  return i;
-}
-#endif
-
-#if ! defined yyoverflow || YYERROR_VERBOSE
-
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
-
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
-
-# ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
-#  ifndef YYSTACK_ALLOC_MAXIMUM
-    /* The OS might guarantee only one guard page at the bottom of the stack,
-       and a page size can be as small as 4096 bytes.  So we cannot safely
-       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
-       to allow for a few compiler-allocated temporary stack slots.  */
-#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
-#  endif
-# else
-#  define YYSTACK_ALLOC YYMALLOC
-#  define YYSTACK_FREE YYFREE
-#  ifndef YYSTACK_ALLOC_MAXIMUM
-#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
-#  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
-       && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
-#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
-#   endif
-#  endif
-#  ifndef YYMALLOC
-#   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
-#   endif
-#  endif
-#  ifndef YYFREE
-#   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-void free (void *); /* INFRINGES ON USER NAME SPACE */
-#   endif
-#  endif
-# endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
-
-#if (! defined yyoverflow \
-     && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
-
-/* A type that is properly aligned for any stack member.  */
-union yyalloc
-{
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
-
-/* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
-
-/* The size of an array large to enough to hold all stacks, each with
-   N elements.  */
-# define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
-      + YYSTACK_GAP_MAXIMUM)
-
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
-
-/* Relocate STACK from its old location to the new one.  The
-   local variables YYSIZE and YYSTACKSIZE give the old and new number of
-   elements in the stack, and YYPTR gives the new location of the
-   stack.  Advance YYPTR to a properly aligned location for the next
-   stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
-
-#endif
-
-/* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  18
-/* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   83
-
-/* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  16
-/* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  11
-/* YYNRULES -- Number of rules.  */
-#define YYNRULES  30
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  61
-
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   270
-
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
-
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
-{
-       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15
-};
-
-#if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     6,     9,    11,    13,    15,    17,    19,
-      21,    26,    33,    35,    40,    42,    45,    50,    56,    65,
-      75,    80,    85,    87,    88,    90,    93,    95,    98,    99,
-     101
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      17,     0,    -1,    18,     9,    -1,    18,    10,    -1,     9,
-      -1,    10,    -1,     8,    -1,    22,    -1,    26,    -1,     7,
-      -1,    12,    19,    18,    13,    -1,    12,    11,    18,    18,
-      18,    13,    -1,     1,    -1,    12,    14,    20,    13,    -1,
-      21,    -1,    21,    20,    -1,    12,     7,    18,    13,    -1,
-      12,     4,     7,    18,    13,    -1,    12,     7,    15,    12,
-      25,    13,    18,    13,    -1,    12,     4,     7,    15,    12,
-      25,    13,    18,    13,    -1,    12,     3,    23,    13,    -1,
-      12,     7,    23,    13,    -1,    24,    -1,    -1,    18,    -1,
-      18,    24,    -1,     7,    -1,     7,    25,    -1,    -1,     5,
-      -1,     6,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint8 yyrline[] =
-{
-       0,    30,    30,    38,    46,    50,    57,    61,    65,    69,
-      73,    77,    81,    88,    94,    98,   104,   109,   112,   115,
-     120,   124,   130,   134,   140,   144,   150,   154,   158,   163,
-     167
-};
-#endif
-
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
-/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
-   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
-static const char *const yytname[] =
-{
-  "$end", "error", "$undefined", "FUNC", "TYPE", "INT", "DOUBLE",
-  "SYMBOL", "QUIT", "EOL", "EOFT", "COND", "LPAREN", "RPAREN", "LET",
-  "LAMBDA", "$accept", "program", "s_expr", "let_section", "let_list",
-  "let_elem", "f_expr", "s_expr_section", "s_expr_list", "arg_list",
-  "number", 0
-};
-#endif
-
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
-{
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270
-};
-# endif
-
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    16,    17,    17,    17,    17,    18,    18,    18,    18,
-      18,    18,    18,    19,    20,    20,    21,    21,    21,    21,
-      22,    22,    23,    23,    24,    24,    25,    25,    25,    26,
-      26
-};
-
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     2,     2,     1,     1,     1,     1,     1,     1,
-       4,     6,     1,     4,     1,     2,     4,     5,     8,     9,
-       4,     4,     1,     0,     1,     2,     1,     2,     0,     1,
-       1
-};
-
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,    12,    29,    30,     9,     6,     4,     5,     0,     0,
-       0,     7,     8,     0,     0,     0,     0,     0,     1,     2,
-       3,     0,     0,    22,     0,     0,     0,     0,    25,    20,
-      21,     0,     0,     0,    14,    10,     0,     0,     0,    13,
-      15,    11,     0,     0,     0,     0,     0,    28,    16,    28,
-      17,    26,     0,     0,    27,     0,     0,     0,     0,    18,
-      19
-};
-
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     9,    21,    17,    33,    34,    11,    22,    23,    52,
-      12
-};
-
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -47
-static const yytype_int8 yypact[] =
-{
-      61,   -47,   -47,   -47,   -47,   -47,   -47,   -47,     7,    20,
-       2,   -47,   -47,    38,    38,    71,     9,    71,   -47,   -47,
-     -47,    52,     8,   -47,    11,    71,    18,    19,   -47,   -47,
-     -47,    71,    -3,    22,    18,   -47,    24,    27,     1,   -47,
-     -47,   -47,    21,    28,    34,    29,    35,    42,   -47,    42,
-     -47,    42,    39,    41,   -47,    71,    71,    48,    50,   -47,
-     -47
-};
-
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
-{
-     -47,   -47,     0,   -47,    40,   -47,   -47,    66,    54,   -46,
-     -47
-};
-
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -25
-static const yytype_int8 yytable[] =
-{
-      10,    37,     1,    53,    38,    54,     2,     3,     4,     5,
-      13,    19,    20,     8,    14,    25,    43,    27,    15,    16,
-      18,    29,     1,    26,    30,    31,     2,     3,     4,     5,
-      32,    36,    35,     8,    42,    39,    45,    41,    44,     1,
-      47,    49,    46,     2,     3,     4,     5,    48,    50,    51,
-       8,   -23,    55,     1,    56,    57,    58,     2,     3,     4,
-       5,    59,     1,    60,     8,   -24,     2,     3,     4,     5,
-       6,     7,     1,     8,    40,    28,     2,     3,     4,     5,
-      24,     0,     0,     8
-};
-
-static const yytype_int8 yycheck[] =
-{
-       0,     4,     1,    49,     7,    51,     5,     6,     7,     8,
-       3,     9,    10,    12,     7,    15,    15,    17,    11,    12,
-       0,    13,     1,    14,    13,    25,     5,     6,     7,     8,
-      12,    31,    13,    12,     7,    13,    15,    13,    38,     1,
-      12,    12,    42,     5,     6,     7,     8,    13,    13,     7,
-      12,    13,    13,     1,    13,    55,    56,     5,     6,     7,
-       8,    13,     1,    13,    12,    13,     5,     6,     7,     8,
-       9,    10,     1,    12,    34,    21,     5,     6,     7,     8,
-      14,    -1,    -1,    12
-};
-
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
-{
-       0,     1,     5,     6,     7,     8,     9,    10,    12,    17,
-      18,    22,    26,     3,     7,    11,    12,    19,     0,     9,
-      10,    18,    23,    24,    23,    18,    14,    18,    24,    13,
-      13,    18,    12,    20,    21,    13,    18,     4,     7,    13,
-      20,    13,     7,    15,    18,    15,    18,    12,    13,    12,
-      13,     7,    25,    25,    25,    13,    13,    18,    18,    13,
-      13
-};
-
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
-
-#define YYFAIL		goto yyerrlab
-
-#define YYRECOVERING()  (!!yyerrstatus)
-
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
-
-/* Enable debugging if requested.  */
-#if YYDEBUG
-
-# ifndef YYFPRINTF
-#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
-#  define YYFPRINTF fprintf
-# endif
-
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
-{
-  if (!yyvaluep)
-    return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
-}
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
-{
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
-
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
-}
-
-/*------------------------------------------------------------------.
-| yy_stack_print -- Print the state stack from its BOTTOM up to its |
-| TOP (included).                                                   |
-`------------------------------------------------------------------*/
-
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
-static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
-{
-  YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
-  YYFPRINTF (stderr, "\n");
-}
-
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
-
-
-/*------------------------------------------------.
-| Report that the YYRULE is going to be reduced.  |
-`------------------------------------------------*/
-
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
-{
-  int yynrhs = yyr2[yyrule];
-  int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
-  /* The symbols being reduced.  */
-  for (yyi = 0; yyi < yynrhs; yyi++)
-    {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
-      fprintf (stderr, "\n");
-    }
-}
-
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
-
-/* Nonzero means print parse trace.  It is left uninitialized so that
-   multiple parsers can coexist.  */
-int yydebug;
-#else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
-# define YY_STACK_PRINT(Bottom, Top)
-# define YY_REDUCE_PRINT(Rule)
-#endif /* !YYDEBUG */
-
-
-/* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
-# define YYINITDEPTH 200
-#endif
-
-/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
-   if the built-in stack extension method is used).
-
-   Do not make this value too large; the results are undefined if
-   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
-   evaluated with infinite-precision integer arithmetic.  */
-
-#ifndef YYMAXDEPTH
-# define YYMAXDEPTH 10000
-#endif
-
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
-
-/*-----------------------------------------------.
-| Release the memory associated to this symbol.  |
-`-----------------------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
-{
-  YYUSE (yyvaluep);
-
-  if (!yymsg)
-    yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
-
-      default:
-	break;
-    }
-}
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-
-/* The look-ahead symbol.  */
-int yychar;
-
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
-
-/* Number of syntax errors so far.  */
-int yynerrs;
-
-
-
-/*----------.
-| yyparse.  |
-`----------*/
-
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
-{
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
-
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
-
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
-
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
-
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
-
-
-
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
-
-  YYSIZE_T yystacksize = YYINITDEPTH;
-
-  /* The variables used to return semantic value and location from the
-     action routines.  */
-  YYSTYPE yyval;
-
-
-  /* The number of symbols on the RHS of the reduced rule.
-     Keep to zero when no symbol should be popped.  */
-  int yylen = 0;
-
-  YYDPRINTF ((stderr, "Starting parse\n"));
-
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
-
-  goto yysetstate;
-
-/*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
-`------------------------------------------------------------*/
- yynewstate:
-  /* In all cases, when you get here, the value and location stacks
-     have just been pushed.  So pushing a state here evens the stacks.  */
-  yyssp++;
-
- yysetstate:
-  *yyssp = yystate;
-
-  if (yyss + yystacksize - 1 <= yyssp)
-    {
-      /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
-
-#ifdef yyoverflow
-      {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
-      }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
-      /* Extend the stack our own way.  */
-      if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
-      yystacksize *= 2;
-      if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
-
-      {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
-#  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
-      }
-# endif
-#endif /* no yyoverflow */
-
-      yyssp = yyss + yysize - 1;
-      yyvsp = yyvs + yysize - 1;
-
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
-
-      if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
-    }
-
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
-
-  goto yybackup;
-
-/*-----------.
-| yybackup.  |
-`-----------*/
-yybackup:
-
-  /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
-
-  /* First try to decide what to do without reference to look-ahead token.  */
-  yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
-    goto yydefault;
-
-  /* Not known => get a look-ahead token if don't already have one.  */
-
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
-  if (yychar == YYEMPTY)
-    {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
-    }
-
-  if (yychar <= YYEOF)
-    {
-      yychar = yytoken = YYEOF;
-      YYDPRINTF ((stderr, "Now at end of input.\n"));
-    }
-  else
-    {
-      yytoken = YYTRANSLATE (yychar);
-      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
-    }
-
-  /* If the proper action on seeing token YYTOKEN is to reduce or to
-     detect an error, take that action.  */
-  yyn += yytoken;
-  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
-    goto yydefault;
-  yyn = yytable[yyn];
-  if (yyn <= 0)
-    {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
-      yyn = -yyn;
-      goto yyreduce;
-    }
-
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
-  /* Count tokens shifted since error; after three, turn off error
-     status.  */
-  if (yyerrstatus)
-    yyerrstatus--;
-
-  /* Shift the look-ahead token.  */
-  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
-  yystate = yyn;
-  *++yyvsp = yylval;
-
-  goto yynewstate;
-
-
-/*-----------------------------------------------------------.
-| yydefault -- do the default action for the current state.  |
-`-----------------------------------------------------------*/
-yydefault:
-  yyn = yydefact[yystate];
-  if (yyn == 0)
-    goto yyerrlab;
-  goto yyreduce;
-
-
-/*-----------------------------.
-| yyreduce -- Do a reduction.  |
-`-----------------------------*/
-yyreduce:
-  /* yyn is the number of a rule to reduce with.  */
-  yylen = yyr2[yyn];
-
-  /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
-
-     Otherwise, the following line sets YYVAL to garbage.
-     This behavior is undocumented and Bison
-     users should not rely upon it.  Assigning to YYVAL
-     unconditionally makes the parser a bit smaller, and it avoids a
-     GCC warning that YYVAL may be used uninitialized.  */
-  yyval = yyvsp[1-yylen];
-
-
-  YY_REDUCE_PRINT (yyn);
-  switch (yyn)
-    {
-        case 2:
-#line 30 "cilisp.y"
-    {
-        //ylog(program, s_expr EOL);
-        if ((yyvsp[(1) - (2)].astNode)) {
-            printRetVal(eval((yyvsp[(1) - (2)].astNode)));
-            freeNode((yyvsp[(1) - (2)].astNode));
-        }
-        YYACCEPT;
-    }
-    break;
-
-  case 3:
-#line 38 "cilisp.y"
-    {
-        //ylog(program, s_expr EOFT);
-        if ((yyvsp[(1) - (2)].astNode)) {
-            printRetVal(eval((yyvsp[(1) - (2)].astNode)));
-            freeNode((yyvsp[(1) - (2)].astNode));
-        }
-        exit(EXIT_SUCCESS);
-    }
-    break;
-
-  case 4:
-#line 46 "cilisp.y"
-    {
-        //ylog(program, EOL);
-        YYACCEPT;  // paranoic; main skips blank lines
-    }
-    break;
-
-  case 5:
-#line 50 "cilisp.y"
-    {
-        //ylog(program, EOFT);
-        exit(EXIT_SUCCESS);
-    }
-    break;
-
-  case 6:
-#line 57 "cilisp.y"
-    {
-        //ylog(s_expr, QUIT);
-        exit(EXIT_SUCCESS);
-    }
-    break;
-
-  case 7:
-#line 61 "cilisp.y"
-    {
-        //ylog(s_expr, f_expr);
-        (yyval.astNode) = (yyvsp[(1) - (1)].astNode);
-    }
-    break;
-
-  case 8:
-#line 65 "cilisp.y"
-    {
-        //ylog(s_expr, number);
-        (yyval.astNode) = (yyvsp[(1) - (1)].astNode);
-    }
-    break;
-
-  case 9:
-#line 69 "cilisp.y"
-    {
-        //ylog(s_expr, SYMBOL);
-        (yyval.astNode) = createSymbolNode((yyvsp[(1) - (1)].ident));
-    }
-    break;
-
-  case 10:
-#line 73 "cilisp.y"
-    {
-        //ylog(s_expr, let_section);
-        (yyval.astNode) = createScopeNode((yyvsp[(2) - (4)].symNode), (yyvsp[(3) - (4)].astNode));
-    }
-    break;
-
-  case 11:
-#line 77 "cilisp.y"
-    {
-        //ylog(s_expr, COND);
-        (yyval.astNode) = createConditionNode((yyvsp[(3) - (6)].astNode), (yyvsp[(4) - (6)].astNode), (yyvsp[(5) - (6)].astNode));
-    }
-    break;
-
-  case 12:
-#line 81 "cilisp.y"
-    {
-        //ylog(s_expr, error);
-        yyerror("unexpected token");
-        (yyval.astNode) = NULL;
-    }
-    break;
-
-  case 13:
-#line 88 "cilisp.y"
-    {
-        //ylog(let_section, let_list);
-        (yyval.symNode) = (yyvsp[(3) - (4)].symNode);
-    }
-    break;
-
-  case 14:
-#line 94 "cilisp.y"
-    {
-        //ylog(let_list, let_elem);
-        (yyval.symNode) = (yyvsp[(1) - (1)].symNode);
-    }
-    break;
-
-  case 15:
-#line 98 "cilisp.y"
-    {
-        //ylog(let_list, let_list);
-        (yyval.symNode) = createLetList((yyvsp[(1) - (2)].symNode), (yyvsp[(2) - (2)].symNode));
-    }
-    break;
-
-  case 16:
-#line 104 "cilisp.y"
-    {
-        //ylog(let_elem, SYMBOL);
-        //ylog(let_elem, s_expr);
-        (yyval.symNode) = createLetElem(VAR_TYPE, NO_TYPE, (yyvsp[(2) - (4)].ident), (yyvsp[(3) - (4)].astNode), NULL);
-    }
-    break;
-
-  case 17:
-#line 109 "cilisp.y"
-    {
-        (yyval.symNode) = createLetElem(VAR_TYPE, (yyvsp[(2) - (5)].ival), (yyvsp[(3) - (5)].ident), (yyvsp[(4) - (5)].astNode), NULL);
-    }
-    break;
-
-  case 18:
-#line 112 "cilisp.y"
-    {
-        (yyval.symNode) = createLetElem(LAMBDA_TYPE, NO_TYPE, (yyvsp[(2) - (8)].ident), (yyvsp[(7) - (8)].astNode), (yyvsp[(5) - (8)].symNode));
-    }
-    break;
-
-  case 19:
-#line 115 "cilisp.y"
-    {
-        (yyval.symNode) = createLetElem(LAMBDA_TYPE, (yyvsp[(2) - (9)].ival), (yyvsp[(3) - (9)].ident), (yyvsp[(8) - (9)].astNode), (yyvsp[(6) - (9)].symNode));
-    }
-    break;
-
-  case 20:
-#line 120 "cilisp.y"
-    {
-        //ylog(f_expr, s_expr_section);
-        (yyval.astNode) = createFunctionNode(NULL, (yyvsp[(2) - (4)].ival), (yyvsp[(3) - (4)].astNode));
-    }
-    break;
-
-  case 21:
-#line 124 "cilisp.y"
-    {
-        //ylog(f_expr, s_expr_section);
-        (yyval.astNode) = createFunctionNode((yyvsp[(2) - (4)].ident), CUSTOM_FUNC, (yyvsp[(3) - (4)].astNode));
-    }
-    break;
-
-  case 22:
-#line 130 "cilisp.y"
-    {
-        //ylog(s_expr_section, s_expr_list);
-        (yyval.astNode) = (yyvsp[(1) - (1)].astNode);
-    }
-    break;
-
-  case 23:
-#line 134 "cilisp.y"
-    {
-        //ylog(s_expr_section, empty);
-        (yyval.astNode) = NULL;
-    }
-    break;
-
-  case 24:
-#line 140 "cilisp.y"
-    {
-        //ylog(s_expr_list, s_expr);
-        (yyval.astNode) = (yyvsp[(1) - (1)].astNode);
-    }
-    break;
-
-  case 25:
-#line 144 "cilisp.y"
-    {
-        //ylog(s_expr, s_expr_list);
-        (yyval.astNode) = addExpressionToList((yyvsp[(1) - (2)].astNode), (yyvsp[(2) - (2)].astNode)); 
-    }
-    break;
-
-  case 26:
-#line 150 "cilisp.y"
-    {
-        //ylog(arg_list, SYMBOL);
-        (yyval.symNode) = createArg((yyvsp[(1) - (1)].ident));
-    }
-    break;
-
-  case 27:
-#line 154 "cilisp.y"
-    {
-        //ylog(arg_list, arg_list);
-        (yyval.symNode) = createArgList((yyvsp[(1) - (2)].ident), (yyvsp[(2) - (2)].symNode));
-    }
-    break;
-
-  case 28:
-#line 158 "cilisp.y"
-    {
-        (yyval.symNode) = NULL;
-    }
-    break;
-
-  case 29:
-#line 163 "cilisp.y"
-    {
-        //ylog(number, INT);
-        (yyval.astNode) = createNumberNode((yyvsp[(1) - (1)].dval), INT_TYPE);
-    }
-    break;
-
-  case 30:
-#line 167 "cilisp.y"
-    {
-        //ylog(number, DOUBLE);
-        (yyval.astNode) = createNumberNode((yyvsp[(1) - (1)].dval), DOUBLE_TYPE);
-    }
-    break;
-
-
-/* Line 1267 of yacc.c.  */
-#line 1635 "y.tab.c"
-      default: break;
-    }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
-
-  YYPOPSTACK (yylen);
-  yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
-
-  *++yyvsp = yyval;
-
-
-  /* Now `shift' the result of the reduction.  Determine what state
-     that goes to, based on the state we popped back to and the rule
-     number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
-
-  goto yynewstate;
-
-
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
-yyerrlab:
-  /* If not already recovering from an error, report this error.  */
-  if (!yyerrstatus)
-    {
-      ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
-    }
-
-
-
-  if (yyerrstatus == 3)
-    {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
-
-      if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
-      else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
-    }
-
-  /* Else will try to reuse look-ahead token after shifting the error
-     token.  */
-  goto yyerrlab1;
-
-
-/*---------------------------------------------------.
-| yyerrorlab -- error raised explicitly by YYERROR.  |
-`---------------------------------------------------*/
-yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
-     this YYERROR.  */
-  YYPOPSTACK (yylen);
-  yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
-  yystate = *yyssp;
-  goto yyerrlab1;
-
-
-/*-------------------------------------------------------------.
-| yyerrlab1 -- common code for both syntax error and YYERROR.  |
-`-------------------------------------------------------------*/
-yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
-
-  for (;;)
-    {
-      yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
-
-      /* Pop the current state because it cannot handle the error token.  */
-      if (yyssp == yyss)
-	YYABORT;
-
-
-      yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
-      YYPOPSTACK (1);
-      yystate = *yyssp;
-      YY_STACK_PRINT (yyss, yyssp);
-    }
-
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
-  *++yyvsp = yylval;
-
-
-  /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
-
-  yystate = yyn;
-  goto yynewstate;
-
-
-/*-------------------------------------.
-| yyacceptlab -- YYACCEPT comes here.  |
-`-------------------------------------*/
-yyacceptlab:
-  yyresult = 0;
-  goto yyreturn;
-
-/*-----------------------------------.
-| yyabortlab -- YYABORT comes here.  |
-`-----------------------------------*/
-yyabortlab:
-  yyresult = 1;
-  goto yyreturn;
-
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
-yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
-  yyresult = 2;
-  /* Fall through.  */
-#endif
-
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
-     this YYABORT or YYACCEPT.  */
-  YYPOPSTACK (yylen);
-  YY_STACK_PRINT (yyss, yyssp);
-  while (yyssp != yyss)
-    {
-      yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
-      YYPOPSTACK (1);
-    }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
-
-#line 171 "cilisp.y"
-
-
-
@@ -0,0 +1,1021 @@
+#include "cilisp.h"
+
+// run:
+// Executes BYTECODE produced by compile() on the operand stack of vm.
+// Dispatch is threaded through a table of label addresses (computed goto),
+// so every instruction jumps straight to the next handler without going
+// back through a switch.
+// With -p, a thread that reaches an OP_FORK while others are idle offers
+// them the operands compiled as tasks, and joins each in turn where its
+// value is needed, so values and warnings come out in the serial order.
+
+// A VM starts out with empty stacks; they grow on first use and are kept
+// for the next run. Numbers for (read) come from readTarget, which
+// sharesInput says is also the program's input.
+VM *createVM(FILE *readTarget, bool sharesInput)
+{
+    VM *vm;
+
+    if ((vm = calloc(sizeof(VM), 1)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+        return NULL;
+    }
+
+    vm->reader = createReader(readTarget, sharesInput);
+    // seeded like rand(), which (rand) used to call, so the sequence is unchanged
+    initstate_r(1, vm->randomState, sizeof(vm->randomState), &vm->random);
+    return vm;
+}
+
+void freeVM(VM *vm)
+{
+    freeReader(vm->reader);
+    free(vm->stack);
+    free(vm->slots);
+    free(vm->frames);
+    free(vm->calls);
+    free(vm->forks);
+    free(vm);
+}
+
+// makes room for needed more values above the operand stack's top
+static void reserveStack(VM *vm, int needed)
+{
+    if (vm->sp + needed <= vm->stackCapacity)
+    {
+        return;
+    }
+
+    while (vm->sp + needed > vm->stackCapacity)
+    {
+        vm->stackCapacity = vm->stackCapacity ? 2 * vm->stackCapacity : 256;
+    }
+    vm->stack = realloc(vm->stack, vm->stackCapacity * sizeof(RET_VAL));
+    if (vm->stack == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+}
+
+static void reserveSlots(VM *vm, int needed)
+{
+    if (vm->slotCount + needed <= vm->slotCapacity)
+    {
+        return;
+    }
+
+    while (vm->slotCount + needed > vm->slotCapacity)
+    {
+        vm->slotCapacity = vm->slotCapacity ? 2 * vm->slotCapacity : 256;
+    }
+    vm->slots = realloc(vm->slots, vm->slotCapacity * sizeof(SLOT));
+    if (vm->slots == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+}
+
+static int pushFrame(VM *vm, int base, int size, int link)
+{
+    if (vm->frameCount == vm->frameCapacity)
+    {
+        vm->frameCapacity = vm->frameCapacity ? 2 * vm->frameCapacity : 64;
+        vm->frames = realloc(vm->frames, vm->frameCapacity * sizeof(ENV_FRAME));
+        if (vm->frames == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+
+    vm->frames[vm->frameCount].base = base;
+    vm->frames[vm->frameCount].size = size;
+    vm->frames[vm->frameCount].link = link;
+    return vm->frameCount++;
+}
+
+static void pushCall(VM *vm, INSTRUCTION *returnPc, int env, int slot)
+{
+    if (vm->callCount == vm->callCapacity)
+    {
+        vm->callCapacity = vm->callCapacity ? 2 * vm->callCapacity : 64;
+        vm->calls = realloc(vm->calls, vm->callCapacity * sizeof(CALL_RECORD));
+        if (vm->calls == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+
+    vm->calls[vm->callCount].returnPc = returnPc;
+    vm->calls[vm->callCount].env = env;
+    vm->calls[vm->callCount].slot = slot;
+    vm->callCount++;
+}
+
+static void pushFork(VM *vm, FORK_GROUP *group)
+{
+    if (vm->forkCount == vm->forkCapacity)
+    {
+        vm->forkCapacity = vm->forkCapacity ? 2 * vm->forkCapacity : 16;
+        vm->forks = realloc(vm->forks, vm->forkCapacity * sizeof(FORK_GROUP *));
+        if (vm->forks == NULL)
+        {
+            yyerror("Memory allocation failed!");
+        }
+    }
+
+    vm->forks[vm->forkCount++] = group;
+}
+
+// after the last join of the newest fork; every task it offered is done with
+static void endFork(VM *vm)
+{
+    free(vm->forks[--vm->forkCount]);
+}
+
+// The tasks an OP_FORK offers, with a copy of the frames from env to the top
+// level. The chain follows lexical links, so it is as long as the scopes are
+// nested, however deep the calls are; and the operands read only arguments
+// and bindings that are already numbers there, which the copy keeps as is.
+static FORK_GROUP *createForkGroup(VM *vm, BYTECODE *bytecode, int firstTask, int env)
+{
+    FORK_GROUP *group;
+    int taskCount = 1;
+    int frameCount = 0;
+    int slotCount = 0;
+
+    while (!bytecode->tasks[firstTask + taskCount - 1].last)
+    {
+        taskCount++;
+    }
+    for (int frame = env; frame >= 0; frame = vm->frames[frame].link)
+    {
+        frameCount++;
+        slotCount += vm->frames[frame].size;
+    }
+
+    // the tasks, slots and frames share one block
+    group = malloc(sizeof(FORK_GROUP) + taskCount * sizeof(FORK_TASK) + slotCount * sizeof(SLOT) + frameCount * sizeof(ENV_FRAME));
+    if (group == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+
+    group->bytecode = bytecode;
+    group->firstTask = firstTask;
+    group->taskCount = taskCount;
+    group->slots = (SLOT *) (group->tasks + taskCount);
+    group->slotCount = slotCount;
+    group->frames = (ENV_FRAME *) (group->slots + slotCount);
+    group->frameCount = frameCount;
+
+    for (int i = 0; i < taskCount; i++)
+    {
+        group->tasks[i] = (FORK_TASK) {.group = group, .index = firstTask + i};
+    }
+
+    slotCount = 0;
+    for (int i = 0, frame = env; frame >= 0; i++, frame = vm->frames[frame].link)
+    {
+        memcpy(group->slots + slotCount, vm->slots + vm->frames[frame].base, vm->frames[frame].size * sizeof(SLOT));
+        group->frames[i].base = slotCount;
+        group->frames[i].size = vm->frames[frame].size;
+        group->frames[i].link = i + 1 < frameCount ? i + 1 : -1;
+        slotCount += vm->frames[frame].size;
+    }
+
+    return group;
+}
+
+// index of the frame depth levels up the lexical chain from env
+static inline int frameAt(VM *vm, int env, int depth)
+{
+    while (depth-- > 0)
+    {
+        env = vm->frames[env].link;
+    }
+    return env;
+}
+
+// Integers are exact int64_t values. Every integer operation is checked, and
+// one that overflows warns and is redone in double precision instead.
+static void overflowed(bool overflow, char *func)
+{
+    if (overflow)
+    {
+        warning("Integer overflow in %s! The result is a double.", func);
+    }
+}
+
+static RET_VAL addNumbers(RET_VAL a, RET_VAL b)
+{
+    int64_t sum;
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        if (!__builtin_add_overflow(a.ival, b.ival, &sum))
+        {
+            return INT_RET_VAL(sum);
+        }
+        overflowed(true, "add");
+    }
+    return DOUBLE_RET_VAL(toDouble(a) + toDouble(b));
+}
+
+static RET_VAL subNumbers(RET_VAL a, RET_VAL b)
+{
+    int64_t difference;
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        if (!__builtin_sub_overflow(a.ival, b.ival, &difference))
+        {
+            return INT_RET_VAL(difference);
+        }
+        overflowed(true, "sub");
+    }
+    return DOUBLE_RET_VAL(toDouble(a) - toDouble(b));
+}
+
+static RET_VAL multNumbers(RET_VAL a, RET_VAL b)
+{
+    int64_t product;
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        if (!__builtin_mul_overflow(a.ival, b.ival, &product))
+        {
+            return INT_RET_VAL(product);
+        }
+        overflowed(true, "mult");
+    }
+    return DOUBLE_RET_VAL(toDouble(a) * toDouble(b));
+}
+
+// integer division rounds toward negative infinity
+static RET_VAL divNumbers(RET_VAL a, RET_VAL b)
+{
+    if (isZero(b))
+    {
+        warning("You cannot divide by zero!");
+        return NAN_RET_VAL;
+    }
+
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        if (a.ival != INT64_MIN || b.ival != -1)
+        {
+            int64_t quotient = a.ival / b.ival;
+            if (a.ival % b.ival != 0 && (a.ival < 0) != (b.ival < 0))
+            {
+                quotient--;
+            }
+            return INT_RET_VAL(quotient);
+        }
+        overflowed(true, "div");
+    }
+    return DOUBLE_RET_VAL(toDouble(a) / toDouble(b));
+}
+
+// the remainder is always in [0, |b|)
+static RET_VAL remNumbers(RET_VAL a, RET_VAL b)
+{
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        if (b.ival == 0)
+        {
+            warning("You cannot divide by zero!");
+            return NAN_RET_VAL;
+        }
+        if (b.ival == -1)
+        {
+            return INT_RET_VAL(0);
+        }
+        int64_t rem = a.ival % b.ival;
+        if (rem < 0)
+        {
+            rem = b.ival < 0 ? rem - b.ival : rem + b.ival;
+        }
+        return INT_RET_VAL(rem);
+    }
+
+    double rem = remainder(toDouble(a), toDouble(b));
+    if (rem < 0)
+    {
+        rem += fabs(toDouble(b));
+    }
+    return DOUBLE_RET_VAL(rem);
+}
+
+// integer powers with a non-negative exponent are computed exactly by squaring
+static RET_VAL powNumbers(RET_VAL a, RET_VAL b)
+{
+    if (a.type == INT_TYPE && b.type == INT_TYPE && b.ival >= 0)
+    {
+        int64_t power = 1;
+        int64_t square = a.ival;
+        int64_t exponent = b.ival;
+        bool overflow = false;
+
+        while (exponent > 0 && !overflow)
+        {
+            if (exponent & 1)
+            {
+                overflow = __builtin_mul_overflow(power, square, &power);
+            }
+            exponent >>= 1;
+            if (exponent > 0 && !overflow)
+            {
+                overflow = __builtin_mul_overflow(square, square, &square);
+            }
+        }
+
+        if (!overflow)
+        {
+            return INT_RET_VAL(power);
+        }
+        overflowed(true, "pow");
+    }
+    return DOUBLE_RET_VAL(pow(toDouble(a), toDouble(b)));
+}
+
+static bool equalNumbers(RET_VAL a, RET_VAL b)
+{
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        return a.ival == b.ival;
+    }
+    return toDouble(a) == toDouble(b);
+}
+
+static bool lessNumbers(RET_VAL a, RET_VAL b)
+{
+    if (a.type == INT_TYPE && b.type == INT_TYPE)
+    {
+        return a.ival < b.ival;
+    }
+    return toDouble(a) < toDouble(b);
+}
+
+static RET_VAL castNumber(RET_VAL number, NUM_TYPE type)
+{
+    if (type == DOUBLE_TYPE)
+    {
+        return DOUBLE_RET_VAL(toDouble(number));
+    }
+    if (type != INT_TYPE || number.type == INT_TYPE)
+    {
+        return number;
+    }
+
+    // 2^63 is the first double past the int64_t range
+    double rounded = round(number.value);
+    if (!(rounded >= -9223372036854775808.0 && rounded < 9223372036854775808.0))
+    {
+        warning("%lf cannot be cast to int! It is kept as a double.", number.value);
+        return number;
+    }
+    if (rounded != number.value)
+    {
+        warning("Precision loss on int cast from %lf to %" PRId64, number.value, (int64_t) rounded);
+    }
+    return INT_RET_VAL((int64_t) rounded);
+}
+
+static RET_VAL readValue(VM *vm)
+{
+    if (!batch_mode)
+    {
+        printf("read :: ");
+    }
+    return readNumber(vm->reader);
+}
+
+// Runs bytecode from its start, or only task's code when task is not NULL:
+// that code starts on an empty operand stack, in a copy of the task group's
+// frames, and ends at its own OP_TASK_END.
+static RET_VAL execute(VM *vm, BYTECODE *bytecode, FORK_TASK *task)
+{
+    // Must be in sync with the OPCODE enum.
+    static void *dispatch[] = {
+            &&op_const,
+            &&op_load_arg,
+            &&op_load_var,
+            &&op_enter,
+            &&op_leave,
+            &&op_cast,
+            &&op_return_thunk,
+            &&op_call,
+            &&op_tail_call,
+            &&op_return,
+            &&op_neg,
+            &&op_abs,
+            &&op_add,
+            &&op_sub,
+            &&op_mult,
+            &&op_div,
+            &&op_rem,
+            &&op_exp,
+            &&op_exp2,
+            &&op_pow,
+            &&op_log,
+            &&op_sqrt,
+            &&op_cbrt,
+            &&op_hypot,
+            &&op_max,
+            &&op_min,
+            &&op_rand,
+            &&op_read,
+            &&op_equal,
+            &&op_less,
+            &&op_greater,
+            &&op_print,
+            &&op_add_int,
+            &&op_sub_int,
+            &&op_mult_int,
+            &&op_equal_int,
+            &&op_less_int,
+            &&op_greater_int,
+            &&op_add_double,
+            &&op_sub_double,
+            &&op_mult_double,
+            &&op_div_double,
+            &&op_equal_double,
+            &&op_less_double,
+            &&op_greater_double,
+            &&op_jump,
+            &&op_jump_if_false,
+            &&op_jump_if_zero,
+            &&op_fork,
+            &&op_join,
+            &&op_task_end,
+            &&op_halt
+    };
+
+    int base = vm->sp;
+    int frameBase = vm->frameCount;
+    int slotBase = vm->slotCount;
+    int callBase = vm->callCount;
+
+    INSTRUCTION *pc = bytecode->code;
+    RET_VAL *constants = bytecode->constants;
+    RET_VAL *top;                           // points at the top value
+    RET_VAL *operand;
+    RET_VAL result;
+    SLOT *slot;
+    FORK_GROUP *group;
+    FORK_TASK *joined;
+    int env = -1;                           // frame of the innermost enclosing scope
+    int rootTask = -1;                      // the task being run, or -1 for the whole program
+    int frame;
+    int count;
+    int64_t integer;
+
+    if (task == NULL)
+    {
+        reserveStack(vm, bytecode->maxStack);
+    }
+    else
+    {
+        // the copied frames go on top of vm's own, outermost first so each links to the one below
+        group = task->group;
+        reserveSlots(vm, group->slotCount);
+        memcpy(vm->slots + vm->slotCount, group->slots, group->slotCount * sizeof(SLOT));
+        for (int i = group->frameCount - 1; i >= 0; i--)
+        {
+            env = pushFrame(vm, vm->slotCount + group->frames[i].base, group->frames[i].size, env);
+        }
+        vm->slotCount += group->slotCount;
+
+        rootTask = task->index;
+        reserveStack(vm, bytecode->tasks[rootTask].need);
+        pc = bytecode->code + bytecode->tasks[rootTask].pc;
+    }
+    top = vm->stack + base - 1;
+
+#define DISPATCH() goto *dispatch[pc->op]
+#define NEXT() { pc++; DISPATCH(); }
+// reallocating the operand stack moves it, so top is rebased around the call
+#define RESERVE(needed) { \
+        vm->sp = (int) (top - vm->stack) + 1; \
+        reserveStack(vm, needed); \
+        top = vm->stack + vm->sp - 1; \
+    }
+
+    DISPATCH();
+
+    op_const:
+        *++top = constants[pc->arg];
+        NEXT();
+
+    op_load_arg:
+        frame = frameAt(vm, env, pc->depth);
+        *++top = vm->slots[vm->frames[frame].base + pc->arg].value;
+        NEXT();
+
+    op_load_var:
+        frame = frameAt(vm, env, pc->depth);
+        slot = &vm->slots[vm->frames[frame].base + pc->arg];
+        if (slot->thunk == FORCED)
+        {
+            *++top = slot->value;
+            NEXT();
+        }
+        if (slot->thunk == FORCING)
+        {
+            warning("Let binding needs its own value to be evaluated! NAN returned!");
+            *++top = NAN_RET_VAL;
+            NEXT();
+        }
+
+        // run the binding's code in its own scope; OP_RETURN_THUNK comes back here
+        pushCall(vm, pc + 1, env, (int) (slot - vm->slots));
+        count = slot->thunk;
+        slot->thunk = FORCING;
+        env = frame;
+        RESERVE(bytecode->thunks[count].need);
+        pc = bytecode->code + bytecode->thunks[count].pc;
+        DISPATCH();
+
+    op_enter:
+        count = bytecode->lets[pc->arg].slotCount;
+        RESERVE(bytecode->lets[pc->arg].need);
+        reserveSlots(vm, count);
+        env = pushFrame(vm, vm->slotCount, count, env);
+        for (int i = 0, thunk = bytecode->lets[pc->arg].firstThunk; i < count; i++, thunk++)
+        {
+            slot = &vm->slots[vm->slotCount++];
+            if (bytecode->thunks[thunk].pc == READY_THUNK)
+            {
+                slot->value = bytecode->thunks[thunk].value;
+                slot->thunk = FORCED;
+            }
+            else
+            {
+                slot->thunk = thunk;
+            }
+        }
+        NEXT();
+
+    op_leave:
+        // let frames are always the newest ones, so popping them is a pointer bump
+        vm->frameCount -= pc->arg;
+        vm->slotCount = vm->frames[vm->frameCount].base;
+        env = vm->frames[vm->frameCount].link;
+        NEXT();
+
+    op_cast:
+        *top = castNumber(*top, pc->arg);
+        NEXT();
+
+    op_return_thunk:
+        vm->callCount--;
+        slot = &vm->slots[vm->calls[vm->callCount].slot];
+        slot->value = *top;
+        slot->thunk = FORCED;
+        env = vm->calls[vm->callCount].env;
+        pc = vm->calls[vm->callCount].returnPc;
+        DISPATCH();
+
+    op_neg:
+        if (top->type == INT_TYPE && top->ival != INT64_MIN)
+        {
+            top->ival = -top->ival;
+            NEXT();
+        }
+        overflowed(top->type == INT_TYPE, "neg");
+        *top = DOUBLE_RET_VAL(-toDouble(*top));
+        NEXT();
+
+    op_abs:
+        if (top->type == INT_TYPE && top->ival != INT64_MIN)
+        {
+            top->ival = llabs(top->ival);
+            NEXT();
+        }
+        overflowed(top->type == INT_TYPE, "abs");
+        *top = DOUBLE_RET_VAL(fabs(toDouble(*top)));
+        NEXT();
+
+    op_add:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            result = addNumbers(result, operand[i]);
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_sub:
+        top--;
+        *top = subNumbers(top[0], top[1]);
+        NEXT();
+
+    op_mult:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            result = multNumbers(result, operand[i]);
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_div:
+        top--;
+        *top = divNumbers(top[0], top[1]);
+        NEXT();
+
+    op_rem:
+        top--;
+        *top = remNumbers(top[0], top[1]);
+        NEXT();
+
+    op_exp:
+        *top = DOUBLE_RET_VAL(exp(toDouble(*top)));
+        NEXT();
+
+    op_exp2:
+        // exact for the integer powers of two that fit
+        if (top->type == INT_TYPE && top->ival >= 0 && top->ival < 63)
+        {
+            top->ival = (int64_t) 1 << top->ival;
+            NEXT();
+        }
+        overflowed(top->type == INT_TYPE && top->ival >= 63, "exp2");
+        *top = DOUBLE_RET_VAL(exp2(toDouble(*top)));
+        NEXT();
+
+    op_pow:
+        top--;
+        *top = powNumbers(top[0], top[1]);
+        NEXT();
+
+    op_log:
+        *top = DOUBLE_RET_VAL(log(toDouble(*top)));
+        NEXT();
+
+    op_sqrt:
+        *top = DOUBLE_RET_VAL(sqrt(toDouble(*top)));
+        NEXT();
+
+    op_cbrt:
+        *top = DOUBLE_RET_VAL(cbrt(toDouble(*top)));
+        NEXT();
+
+    op_hypot:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = DOUBLE_RET_VAL(0);
+        for (int i = 0; i < count; i++)
+        {
+            double value = toDouble(operand[i]);
+            result.value += value * value;
+        }
+        result.value = sqrt(result.value);
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_max:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            if (lessNumbers(result, operand[i]))
+            {
+                result = operand[i];
+            }
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_min:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            if (lessNumbers(operand[i], result))
+            {
+                result = operand[i];
+            }
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_rand:
+        random_r(&vm->random, &count);
+        *++top = DOUBLE_RET_VAL((double) count / (double) RAND_MAX);
+        NEXT();
+
+    op_read:
+        *++top = readValue(vm);
+        NEXT();
+
+    op_equal:
+        top--;
+        *top = INT_RET_VAL(equalNumbers(top[0], top[1]));
+        NEXT();
+
+    op_less:
+        top--;
+        *top = INT_RET_VAL(lessNumbers(top[0], top[1]));
+        NEXT();
+
+    op_greater:
+        top--;
+        *top = INT_RET_VAL(lessNumbers(top[1], top[0]));
+        NEXT();
+
+    op_print:
+        printRetVal(*top);
+        NEXT();
+
+    // The specialized forms read ival or value directly. An int form that
+    // overflows hands that step, and the rest, to the checked helpers.
+    op_add_int:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            if (result.type == INT_TYPE && !__builtin_add_overflow(result.ival, operand[i].ival, &integer))
+            {
+                result.ival = integer;
+            }
+            else
+            {
+                result = addNumbers(result, operand[i]);
+            }
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_sub_int:
+        top--;
+        if (__builtin_sub_overflow(top[0].ival, top[1].ival, &integer))
+        {
+            *top = subNumbers(top[0], top[1]);
+            NEXT();
+        }
+        top->ival = integer;
+        NEXT();
+
+    op_mult_int:
+        count = pc->arg;
+        operand = top - count + 1;
+        result = *operand;
+        for (int i = 1; i < count; i++)
+        {
+            if (result.type == INT_TYPE && !__builtin_mul_overflow(result.ival, operand[i].ival, &integer))
+            {
+                result.ival = integer;
+            }
+            else
+            {
+                result = multNumbers(result, operand[i]);
+            }
+        }
+        top = operand;
+        *top = result;
+        NEXT();
+
+    op_equal_int:
+        top--;
+        top->ival = top[0].ival == top[1].ival;
+        NEXT();
+
+    op_less_int:
+        top--;
+        top->ival = top[0].ival < top[1].ival;
+        NEXT();
+
+    op_greater_int:
+        top--;
+        top->ival = top[0].ival > top[1].ival;
+        NEXT();
+
+    op_add_double:
+        count = pc->arg;
+        operand = top - count + 1;
+        for (int i = 1; i < count; i++)
+        {
+            operand->value += operand[i].value;
+        }
+        top = operand;
+        NEXT();
+
+    op_sub_double:
+        top--;
+        top->value -= top[1].value;
+        NEXT();
+
+    op_mult_double:
+        count = pc->arg;
+        operand = top - count + 1;
+        for (int i = 1; i < count; i++)
+        {
+            operand->value *= operand[i].value;
+        }
+        top = operand;
+        NEXT();
+
+    op_div_double:
+        top--;
+        if (top[1].value == 0)
+        {
+            warning("You cannot divide by zero!");
+            *top = NAN_RET_VAL;
+            NEXT();
+        }
+        top->value /= top[1].value;
+        NEXT();
+
+    op_equal_double:
+        top--;
+        *top = INT_RET_VAL(top[0].value == top[1].value);
+        NEXT();
+
+    op_less_double:
+        top--;
+        *top = INT_RET_VAL(top[0].value < top[1].value);
+        NEXT();
+
+    op_greater_double:
+        top--;
+        *top = INT_RET_VAL(top[0].value > top[1].value);
+        NEXT();
+
+    op_call:
+        // the arguments move from the operand stack into the new frame's slots
+        count = bytecode->functions[pc->arg].argCount;
+        frame = frameAt(vm, env, pc->depth);
+        reserveSlots(vm, count);
+        top -= count;
+        for (int i = 0; i < count; i++)
+        {
+            vm->slots[vm->slotCount + i].value = top[i + 1];
+        }
+        pushCall(vm, pc + 1, env, -1);
+        env = pushFrame(vm, vm->slotCount, count, frame);
+        vm->slotCount += count;
+        RESERVE(bytecode->functions[pc->arg].need);
+        pc = bytecode->code + bytecode->functions[pc->arg].pc;
+        DISPATCH();
+
+    op_tail_call:
+        // env is the running lambda's frame; the arguments overwrite its slots
+        count = bytecode->functions[pc->arg].argCount;
+        vm->frames[env].link = frameAt(vm, env, pc->depth);
+        vm->slotCount = vm->frames[env].base;
+        vm->frames[env].size = count;
+        reserveSlots(vm, count);
+        top -= count;
+        for (int i = 0; i < count; i++)
+        {
+            vm->slots[vm->slotCount + i].value = top[i + 1];
+        }
+        vm->slotCount += count;
+        RESERVE(bytecode->functions[pc->arg].need);
+        pc = bytecode->code + bytecode->functions[pc->arg].pc;
+        DISPATCH();
+
+    op_return:
+        vm->slotCount = vm->frames[env].base;
+        vm->frameCount--;
+        vm->callCount--;
+        env = vm->calls[vm->callCount].env;
+        pc = vm->calls[vm->callCount].returnPc;
+        DISPATCH();
+
+    op_jump:
+        pc = bytecode->code + pc->arg;
+        DISPATCH();
+
+    op_jump_if_false:
+        if (isZero(*top--))
+        {
+            pc = bytecode->code + pc->arg;
+            DISPATCH();
+        }
+        NEXT();
+
+    op_jump_if_zero:
+        if ((top--)->ival == 0)
+        {
+            pc = bytecode->code + pc->arg;
+            DISPATCH();
+        }
+        NEXT();
+
+    op_fork:
+        // NULL stands for a fork no thread was offered, whose tasks all run inline
+        group = wantsFork() ? createForkGroup(vm, bytecode, pc->arg, env) : NULL;
+        pushFork(vm, group);
+        if (group != NULL)
+        {
+            forkTasks(group);
+        }
+        NEXT();
+
+    op_join:
+        group = vm->forks[vm->forkCount - 1];
+        if (group == NULL)
+        {
+            NEXT();
+        }
+
+        // another thread's task may be run on this VM while waiting, above the current top
+        vm->sp = (int) (top - vm->stack) + 1;
+        joined = &group->tasks[pc->arg - group->firstTask];
+        if (joinTask(vm, joined))
+        {
+            NEXT();
+        }
+        top = vm->stack + vm->sp - 1;
+
+        fwrite(joined->output, 1, joined->outputSize, resultStream());
+        free(joined->output);
+        *++top = joined->result;
+        if (bytecode->tasks[pc->arg].last)
+        {
+            endFork(vm);
+        }
+        pc = bytecode->code + bytecode->tasks[pc->arg].end;
+        DISPATCH();
+
+    op_task_end:
+        // the same task can be running inline in a call this one made, which has its own call records
+        if (pc->arg == rootTask && vm->callCount == callBase)
+        {
+            goto op_halt;
+        }
+        if (bytecode->tasks[pc->arg].last)
+        {
+            endFork(vm);
+        }
+        NEXT();
+
+    op_halt:
+        result = *top;
+        vm->sp = base;
+        vm->frameCount = frameBase;
+        vm->slotCount = slotBase;
+        vm->callCount = callBase;
+        return result;
+
+#undef RESERVE
+#undef NEXT
+#undef DISPATCH
+}
+
+RET_VAL run(VM *vm, BYTECODE *bytecode)
+{
+    if (vm == NULL)
+    {
+        yyerror("NULL vm passed into run!");
+        return NAN_RET_VAL;
+    }
+    return execute(vm, bytecode, NULL);
+}
+
+// Runs a task another thread offered, keeping what it writes for the joining thread.
+void runTask(VM *vm, FORK_TASK *task)
+{
+    FILE *results = thread_output;
+
+    if ((thread_output = open_memstream(&task->output, &task->outputSize)) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    task->result = execute(vm, task->group->bytecode, task);
+    fclose(thread_output);
+    thread_output = results;
+}
+
+// eval:
+// Folds, resolves, types and compiles node, then runs it on vm.
+RET_VAL eval(AST_NODE *node, VM *vm)
+{
+    if (!node)
+    {
+        yyerror("NULL ast node passed into eval!");
+        return NAN_RET_VAL;
+    }
+
+    fold(node, vm);
+    resolve(node);
+    infer(node);
+    BYTECODE *bytecode = compile(node);
+    RET_VAL result = run(vm, bytecode);
+    freeBytecode(bytecode);
+
+    return result;
+}
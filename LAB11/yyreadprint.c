@@ -1,93 +1,302 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "cilisp.h"
 
 #define INITIAL_BUFFER_SIZE 128
+#define READ_BLOCK_SIZE (64 * 1024)
+#define TRACE_RING_SIZE (64 * 1024)
 
-// Because getline is inconsistent across compilers
-// and Bison needs extra terminators after the line...
-size_t yyreadline(char **lineptr, size_t *n, FILE *stream, size_t n_terminate)
+// Input is read in large blocks, and lines are cut out of them with memchr.
+// Each parser has its own block, made on its first read. A terminal is
+// still read a character at a time, since a block read would wait for more
+// than a line, and so is an input shared with the read target, which (read)
+// must find exactly where the last line ended. Decided once, when the
+// parser is made, and kept in blockInput.
+static bool readsInBlocks(PARSER *parser)
+{
+    return parser->input != parser->readTarget && !isatty(fileno(parser->input));
+}
+
+// grows the line buffer so needed more bytes fit after its first length
+static bool reserveLine(char **lineptr, size_t *n, size_t length, size_t needed)
 {
-    char *bufptr = NULL;
-    char *p;
-    size_t size;
-    char c;
+    size_t size = *n ? *n : INITIAL_BUFFER_SIZE;
+    char *bufptr;
 
-    if (lineptr == NULL)
+    if (*lineptr != NULL && length + needed <= *n)
     {
-        return (size_t) -1;
+        return true;
     }
-    if (stream == NULL)
+
+    while (length + needed > size)
+    {
+        size = 2 * size;
+    }
+    if ((bufptr = realloc(*lineptr, size)) == NULL)
+    {
+        return false;
+    }
+
+    *lineptr = bufptr;
+    *n = size;
+    return true;
+}
+
+// Because getline is inconsistent across compilers
+// and Bison needs extra terminators after the line...
+// Like getline, *lineptr is reused and *n is its size; the line's length,
+// terminators included, is returned. Lines come from parser's input; at
+// its end EOF is stored as the line's last character.
+size_t yyreadline(PARSER *parser, char **lineptr, size_t *n, size_t n_terminate)
+{
+    FILE *stream = parser->input;
+    size_t length = 0;
+    char *newline;
+    size_t count;
+    int c;
+
+    if (lineptr == NULL || n == NULL || stream == NULL)
     {
         return (size_t) -1;
     }
-    if (n == NULL)
+    if (parser->blockInput && parser->block == NULL && (parser->block = malloc(READ_BLOCK_SIZE)) == NULL)
     {
         return (size_t) -1;
     }
-    bufptr = *lineptr;
-    size = *n;
 
-    c = 0;
-    if (bufptr == NULL)
+    if (!parser->blockInput)
     {
-        bufptr = malloc(INITIAL_BUFFER_SIZE);
-        if (bufptr == NULL)
+        do
         {
-            return (size_t) -1;
-        }
-        size = INITIAL_BUFFER_SIZE;
+            if (!reserveLine(lineptr, n, length, 1 + n_terminate))
+            {
+                return (size_t) -1;
+            }
+            c = fgetc(stream);
+            (*lineptr)[length++] = (char) c;
+        } while (c != '\n' && c != EOF);
     }
-    p = bufptr;
-    while (c != EOF)
+    else
     {
-        c = (char) fgetc(stream);
-        if ((p - bufptr + 1 + n_terminate) > (size))
+        do
         {
-            unsigned long offset = p - bufptr;
-            size = 2 * size;
-            bufptr = realloc(bufptr, size);
-            if (bufptr == NULL)
+            if (parser->blockStart == parser->blockEnd)
+            {
+                parser->blockStart = 0;
+                parser->blockEnd = fread(parser->block, 1, READ_BLOCK_SIZE, stream);
+            }
+            if (parser->blockEnd == 0)
+            {
+                if (!reserveLine(lineptr, n, length, 1 + n_terminate))
+                {
+                    return (size_t) -1;
+                }
+                (*lineptr)[length++] = (char) EOF;
+                break;
+            }
+
+            char *block = parser->block;
+            newline = memchr(block + parser->blockStart, '\n', parser->blockEnd - parser->blockStart);
+            count = newline ? (size_t) (newline - block) + 1 - parser->blockStart : parser->blockEnd - parser->blockStart;
+            if (!reserveLine(lineptr, n, length, count + n_terminate))
             {
                 return (size_t) -1;
             }
-            p = bufptr + offset;
-        }
-        *p++ = c;
-        if (c == '\n')
-        {
-            break;
-        }
+            memcpy(*lineptr + length, block + parser->blockStart, count);
+            length += count;
+            parser->blockStart += count;
+        } while (newline == NULL);
     }
 
-    while (n_terminate > 0)
+    memset(*lineptr + length, '\0', n_terminate);
+    return length + n_terminate;
+}
+
+// Maps the whole of stream for a single scanner to run over, followed by
+// the EOF the lexer ends on and the two NULs flex needs; *n is set to the
+// size to give yy_scan_buffer. The file is mapped privately over zeroed
+// pages, so the padding never runs past the mapping and flex may write
+// into the text without changing the file. Returns NULL if stream is not
+// a regular file that can be mapped.
+char *yymapinput(FILE *stream, size_t *n)
+{
+    struct stat status;
+    char *bytes;
+
+    if (fstat(fileno(stream), &status) != 0 || !S_ISREG(status.st_mode))
     {
-        *p++ = '\0';
-        n_terminate--;
+        return NULL;
     }
 
-    *n = p - bufptr;
-    bufptr = realloc(bufptr, *n);
-    *lineptr = bufptr;
+    size_t size = (size_t) status.st_size;
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t mapped = (size + 3 + page - 1) / page * page;
+
+    bytes = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bytes == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (size > 0 && mmap(bytes, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fileno(stream), 0) == MAP_FAILED)
+    {
+        munmap(bytes, mapped);
+        return NULL;
+    }
 
-    return (p - bufptr);
+    bytes[size] = (char) EOF;
+    bytes[size + 1] = '\0';
+    bytes[size + 2] = '\0';
+    *n = size + 3;
+    return bytes;
 }
 
+// Echoes one line, which need not be followed by a NUL when
+// n_extra_terminates is 0. The end of the input is shown as EOF.
 void yyprintline(char *line, size_t len, size_t n_extra_terminates)
 {
     size_t lastIndex = len - 1 - n_extra_terminates;
     char lastChar = line[lastIndex];
 
-
     if (lastChar == EOF)
     {
-        line[lastIndex] = '\0';
-        if (lastIndex == 0) printf("%sEOF\n", line);
-        else printf("%s\n", line);
-        line[lastIndex] = EOF;
+        fwrite(line, 1, lastIndex, stdout);
+        printf(lastIndex == 0 ? "EOF\n" : "\n");
     }
     else
     {
-        printf("%s", line);
+        fwrite(line, 1, lastIndex + 1, stdout);
     }
 }
+
+// Token tracing (-t) goes through a ring of text that is written out in
+// bulk: whenever the next token does not fit in it, and once more when the
+// parser is freed. head and tail only grow; the ring is indexed by them mod
+// its size.
+struct trace_ring {
+    FILE *log;
+    size_t head;
+    size_t tail;
+    char text[TRACE_RING_SIZE];
+};
+
+static void writeTraceRing(struct trace_ring *trace, char *data, size_t length)
+{
+    while (length > 0)
+    {
+        size_t index = trace->head % TRACE_RING_SIZE;
+        size_t count = TRACE_RING_SIZE - index < length ? TRACE_RING_SIZE - index : length;
+        memcpy(trace->text + index, data, count);
+        trace->head += count;
+        data += count;
+        length -= count;
+    }
+}
+
+// writes everything in the ring to its log, in at most two pieces
+static void drainTrace(struct trace_ring *trace)
+{
+    while (trace->tail != trace->head)
+    {
+        size_t index = trace->tail % TRACE_RING_SIZE;
+        size_t count = trace->head - trace->tail < TRACE_RING_SIZE - index ? trace->head - trace->tail : TRACE_RING_SIZE - index;
+        fwrite(trace->text + index, 1, count, trace->log);
+        trace->tail += count;
+    }
+    fflush(trace->log);
+}
+
+// Starts tracing every token parser's scanner returns to log. The scanner
+// pays a single branch per token when parser->trace is NULL.
+void yystarttrace(PARSER *parser, FILE *log)
+{
+    if ((parser->trace = calloc(1, sizeof(struct trace_ring))) == NULL)
+    {
+        yyerror("Memory allocation failed!");
+    }
+    parser->trace->log = log;
+}
+
+void yystoptrace(PARSER *parser)
+{
+    if (parser->trace != NULL)
+    {
+        drainTrace(parser->trace);
+        free(parser->trace);
+        parser->trace = NULL;
+    }
+}
+
+void yytracetoken(struct trace_ring *trace, char *token, char *text, size_t length)
+{
+    size_t tokenLength = strlen(token);
+    size_t entryLength = tokenLength + length + 10; // LEX: %s "%s"\n
+
+    if (TRACE_RING_SIZE - (trace->head - trace->tail) < entryLength)
+    {
+        drainTrace(trace);
+    }
+    if (entryLength > TRACE_RING_SIZE)
+    {
+        fprintf(trace->log, "LEX: %s \"%.*s\"\n", token, (int) length, text);
+        return;
+    }
+
+    writeTraceRing(trace, "LEX: ", 5);
+    writeTraceRing(trace, token, tokenLength);
+    writeTraceRing(trace, " \"", 2);
+    writeTraceRing(trace, text, length);
+    writeTraceRing(trace, "\"\n", 2);
+}
+
+// The scanner's YY_INPUT: feeds it parser's input, where an expression may
+// continue on the next line. Outside batch mode input goes one line at a
+// time, each after a prompt and echoed if the parser echoes its input; blank
+// lines are skipped without one. In batch mode whole blocks go straight to
+// flex, followed by EOF at the end, so no line is ever held in full.
+size_t yyreadinput(PARSER *parser, char *buf, size_t max_size)
+{
+    if (batch_mode && parser->blockInput)
+    {
+        size_t count = fread(buf, 1, max_size, parser->input);
+        if (count > 0 || parser->inputEnded)
+        {
+            return count;
+        }
+        parser->inputEnded = true;
+        buf[0] = (char) EOF;
+        return 1;
+    }
+
+    if (parser->lineOffset == parser->lineLength)
+    {
+        if (!batch_mode)
+        {
+            printf("\n> ");
+        }
+
+        do
+        {
+            parser->lineLength = yyreadline(parser, &parser->line, &parser->lineSize, 0);
+        } while (parser->lineLength != (size_t) -1 && parser->line[0] == '\n');
+
+        if (parser->lineLength == (size_t) -1)
+        {
+            parser->lineLength = 0;
+            parser->lineOffset = 0;
+            return 0;
+        }
+        if (parser->echoInput && !batch_mode)
+        {
+            yyprintline(parser->line, parser->lineLength, 0);
+        }
+        parser->lineOffset = 0;
+    }
+
+    size_t count = parser->lineLength - parser->lineOffset < max_size ? parser->lineLength - parser->lineOffset : max_size;
+    memcpy(buf, parser->line + parser->lineOffset, count);
+    parser->lineOffset += count;
+    return count;
+}